@@ -18,7 +18,45 @@ graph_t *graph_create(void)
 	}
 
 	graph->nb_vertices = 0;
+	graph->nb_slots = 0;
 	graph->vertices = NULL;
+	graph->vertices_tail = NULL;
+	graph->free_vertices = NULL;
+	graph->track_in_edges = 0;
+	graph->nb_duplicate_edges = 0;
+	graph->buckets = NULL;
+	graph->nb_buckets = 0;
+	graph->arena = NULL;
+	graph->mapping = NULL;
+	graph->mapping_size = 0;
+
+	return (graph);
+}
+
+/**
+ * graph_create_arena - Creates a graph whose vertices, edges and content
+ * strings are carved out of large slabs, so that building it costs a few
+ * malloc calls and deleting it a few free calls.
+ * @slab_size: Size of a slab in bytes, or 0 for GRAPH_ARENA_SLAB_SIZE.
+ *
+ * Return: A pointer to the allocated structure, or NULL on failure.
+ */
+graph_t *graph_create_arena(size_t slab_size)
+{
+	graph_t *graph;
+
+	graph = graph_create();
+	if (graph == NULL)
+		return (NULL);
+
+	graph->arena = malloc(sizeof(graph_arena_t));
+	if (graph->arena == NULL)
+	{
+		free(graph);
+		return (NULL);
+	}
+	graph->arena->slabs = NULL;
+	graph->arena->slab_size = slab_size ? slab_size : GRAPH_ARENA_SLAB_SIZE;
 
 	return (graph);
 }
@@ -3,74 +3,78 @@
 #include "graphs.h"
 
 /**
- * find_vertex_by_content - Helper function to find a vertex by its content.
- * @graph: Pointer to the graph.
- * @str: The content string to search for.
- * Return: Pointer to the vertex if found, NULL otherwise.
- */
-static vertex_t *find_vertex_by_content(graph_t *graph, const char *str)
-{
-	vertex_t *current_vertex;
-
-	if (graph == NULL || str == NULL)
-		return (NULL);
-
-	current_vertex = graph->vertices;
-	while (current_vertex != NULL)
-	{
-		if (strcmp(current_vertex->content, str) == 0)
-			return (current_vertex);
-		current_vertex = current_vertex->next;
-	}
-	return (NULL);
-}
-
-/**
- * graph_add_vertex - Adds a vertex to an existing graph.
- * @graph: Pointer to the graph to add the vertex to.
- * @str: The string to store in the new vertex.
+ * graph_insert_vertex - Adds a vertex whose content is known not to be
+ * in the graph yet, without looking it up first. Bulk loaders that
+ * already searched for the content, or generate unique ones, use it to
+ * save a probe of the hash index per vertex.
+ * The memory and index of a previously removed vertex are reused when
+ * there is one, so that indices stay below graph_s::nb_slots.
+ * @graph: Pointer to the (writable) graph to add the vertex to.
+ * @str: The string to store in the new vertex, not in the graph yet.
  * Return: Pointer to the created vertex, or NULL on failure.
  */
-vertex_t *graph_add_vertex(graph_t *graph, const char *str)
+vertex_t *graph_insert_vertex(graph_t *graph, const char *str)
 {
 	vertex_t *new_vertex;
-	vertex_t *current_vertex;
+	char *content;
 
-	if (graph == NULL || str == NULL)
+	/* Make room in the index first, so that registering cannot fail */
+	if (!graph_index_reserve(graph, graph->nb_vertices + 1))
 		return (NULL);
-
-	/* Check if a vertex with the same content already exists */
-	if (find_vertex_by_content(graph, str) != NULL)
-		return (NULL);
-
-	new_vertex = malloc(sizeof(vertex_t));
-	if (new_vertex == NULL)
+	content = graph_strdup(graph, str);
+	if (content == NULL)
 		return (NULL);
 
-	new_vertex->content = strdup(str);
-	if (new_vertex->content == NULL)
+	new_vertex = graph->free_vertices;
+	if (new_vertex != NULL)
+		graph->free_vertices = new_vertex->next;
+	else
 	{
-		free(new_vertex);
-		return (NULL);
+		new_vertex = graph_alloc(graph, sizeof(vertex_t));
+		if (new_vertex == NULL)
+		{
+			graph_free(graph, content);
+			return (NULL);
+		}
+		new_vertex->index = graph->nb_slots++;
 	}
 
+	new_vertex->content = content;
 	new_vertex->nb_edges = 0;
 	new_vertex->edges = NULL;
+	new_vertex->edges_tail = NULL;
+	new_vertex->edge_set = NULL;
+	new_vertex->edge_set_size = 0;
+	new_vertex->in_edges = NULL;
 	new_vertex->next = NULL;
+	new_vertex->prev = graph->vertices_tail;
+	graph_index_insert(graph, new_vertex);
 
 	/* Add the new vertex to the end of the adjacency list */
 	if (graph->vertices == NULL)
-	{
 		graph->vertices = new_vertex;
-	}
 	else
-	{
-		current_vertex = graph->vertices;
-		while (current_vertex->next != NULL)
-			current_vertex = current_vertex->next;
-		current_vertex->next = new_vertex;
-	}
-	new_vertex->index = graph->nb_vertices;
+		graph->vertices_tail->next = new_vertex;
+	graph->vertices_tail = new_vertex;
 	graph->nb_vertices++;
 	return (new_vertex);
 }
+
+/**
+ * graph_add_vertex - Adds a vertex to an existing graph.
+ * @graph: Pointer to the graph to add the vertex to.
+ * @str: The string to store in the new vertex.
+ * Return: Pointer to the created vertex, or NULL on failure or if a
+ * vertex with the same content exists.
+ * Mapped graphs are read-only and always fail.
+ */
+vertex_t *graph_add_vertex(graph_t *graph, const char *str)
+{
+	if (graph == NULL || str == NULL || graph->mapping != NULL)
+		return (NULL);
+
+	/* Check if a vertex with the same content already exists */
+	if (graph_find_vertex(graph, str) != NULL)
+		return (NULL);
+	return (graph_insert_vertex(graph, str));
+}
@@ -1,36 +1,67 @@
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include "graphs.h"
 
+/**
+ * delete_edges - Frees a linked list of edges.
+ * @edge: Pointer to the head of the list.
+ */
+static void delete_edges(edge_t *edge)
+{
+	edge_t *temp_edge;
+
+	while (edge != NULL)
+	{
+		temp_edge = edge;
+		edge = edge->next;
+		free(temp_edge);
+	}
+}
+
+/**
+ * delete_vertices - Frees a linked list of vertices, with their edges.
+ * @vertex: Pointer to the head of the list.
+ */
+static void delete_vertices(vertex_t *vertex)
+{
+	vertex_t *temp_vertex;
+
+	while (vertex != NULL)
+	{
+		delete_edges(vertex->edges);
+		delete_edges(vertex->in_edges);
+		free(vertex->edge_set);
+		free(vertex->content); /* Free the duplicated string */
+		temp_vertex = vertex;
+		vertex = vertex->next;
+		free(temp_vertex);
+	}
+}
+
 /**
  * graph_delete - Completely deletes a graph.
+ * The nodes of an arena-backed graph are released slab by slab, and a
+ * mapped graph is simply unmapped.
  * @graph: Pointer to the graph to delete.
  */
 void graph_delete(graph_t *graph)
 {
-	vertex_t *current_vertex;
-	vertex_t *temp_vertex;
-	edge_t *current_edge;
-	edge_t *temp_edge;
-
 	if (graph == NULL)
 		return;
+	if (graph->mapping != NULL)
+	{
+		munmap(graph->mapping, graph->mapping_size);
+		return;
+	}
 
-	current_vertex = graph->vertices;
-	while (current_vertex != NULL)
+	if (graph->arena == NULL)
 	{
-		current_edge = current_vertex->edges;
-		while (current_edge != NULL)
-		{
-			temp_edge = current_edge;
-			current_edge = current_edge->next;
-			free(temp_edge);
-		}
-		free(current_vertex->content); /* Free the duplicated string */
-		temp_vertex = current_vertex;
-		current_vertex = current_vertex->next;
-		free(temp_vertex);
+		delete_vertices(graph->vertices);
+		delete_vertices(graph->free_vertices);
 	}
 
+	graph_arena_delete(graph->arena);
+	free(graph->buckets);
 	free(graph);
 }
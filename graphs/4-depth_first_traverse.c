@@ -3,38 +3,100 @@
 #include <string.h>
 #include "graphs.h"
 
+#define DFS_STACK_MIN 64 /* Initial number of frames of the stack */
 
 /**
- * dfs_recursive - Helper function for depth_first_traverse.
- * @vertex: The current vertex being visited.
- * @visited: An array to keep track of visited vertices.
- * @depth: The current depth of the traversal.
- * @action: The action function to call for each visited vertex.
- * @max_depth_ptr: Pointer to store the maximum depth found.
+ * struct dfs_frame_s - Frame of the explicit depth-first stack.
+ * @vertex: The vertex being explored.
+ * @edge: The next edge of @vertex to follow.
+ */
+typedef struct dfs_frame_s
+{
+	const vertex_t *vertex;
+	const edge_t *edge;
+} dfs_frame_t;
+
+/**
+ * dfs_push - Pushes a vertex on the stack, growing it when full.
+ * The stack never needs more frames than there are vertices, so it is
+ * doubled up to that bound at most.
+ * @stack: Pointer to the stack array.
+ * @size: Pointer to the number of frames allocated.
+ * @depth: Depth of the vertex, i.e. the frame to fill.
+ * @vertex: The vertex to push.
+ * @nb_vertices: Number of vertices in the graph.
+ * Return: 1 on success, 0 on failure.
  */
-static void dfs_recursive(const vertex_t *vertex, int *visited,
-						  size_t depth, void (*action)(const vertex_t *v, size_t depth), size_t *max_depth_ptr)
+static int dfs_push(dfs_frame_t **stack, size_t *size, size_t depth,
+					const vertex_t *vertex, size_t nb_vertices)
 {
-	edge_t *edge;
+	dfs_frame_t *grown;
+	size_t new_size;
 
-	if (vertex == NULL || visited == NULL || action == NULL)
-		return;
+	if (depth == *size)
+	{
+		new_size = *size * 2 < nb_vertices ? *size * 2 : nb_vertices;
+		grown = realloc(*stack, sizeof(**stack) * new_size);
+		if (grown == NULL)
+			return (0);
+		*stack = grown;
+		*size = new_size;
+	}
+	(*stack)[depth].vertex = vertex;
+	(*stack)[depth].edge = vertex->edges;
+	return (1);
+}
 
-	visited[vertex->index] = 1; /* Mark as visited */
-	action(vertex, depth);
+/**
+ * dfs_iterative - Helper function for depth_first_traverse.
+ * Walks the graph with an explicit stack of (vertex, next edge) frames, so
+ * that vertices are visited in the same order and at the same depth as a
+ * recursive walk, whatever the length of the paths.
+ * @graph: Pointer to the graph to traverse.
+ * @visited: An array to keep track of visited vertices.
+ * @action: The action function to call for each visited vertex.
+ * Return: The maximum depth found, or (size_t)-1 on allocation failure.
+ */
+static size_t dfs_iterative(const graph_t *graph, unsigned char *visited,
+							void (*action)(const vertex_t *v, size_t depth))
+{
+	dfs_frame_t *stack, *top;
+	size_t size, depth = 0, max_depth = 0;
+	const vertex_t *dest;
 
-	if (depth > *max_depth_ptr)
-		*max_depth_ptr = depth;
+	size = graph->nb_vertices < DFS_STACK_MIN ? graph->nb_vertices : DFS_STACK_MIN;
+	stack = malloc(sizeof(*stack) * size);
+	if (stack == NULL)
+		return ((size_t)-1);
 
-	edge = vertex->edges;
-	while (edge != NULL)
+	visited[graph->vertices->index] = 1; /* Mark as visited */
+	action(graph->vertices, 0);
+	dfs_push(&stack, &size, 0, graph->vertices, graph->nb_vertices);
+	while (1)
 	{
-		if (edge->dest != NULL && visited[edge->dest->index] == 0)
+		top = &stack[depth];
+		if (top->edge == NULL)
+		{
+			if (depth-- == 0)
+				break;
+			continue;
+		}
+		dest = top->edge->dest;
+		top->edge = top->edge->next;
+		if (dest == NULL || visited[dest->index])
+			continue;
+		visited[dest->index] = 1;
+		action(dest, ++depth);
+		if (depth > max_depth)
+			max_depth = depth;
+		if (!dfs_push(&stack, &size, depth, dest, graph->nb_vertices))
 		{
-			dfs_recursive(edge->dest, visited, depth + 1, action, max_depth_ptr);
+			max_depth = (size_t)-1;
+			break;
 		}
-		edge = edge->next;
 	}
+	free(stack);
+	return (max_depth);
 }
 
 /**
@@ -48,23 +110,19 @@ static void dfs_recursive(const vertex_t *vertex, int *visited,
  */
 size_t depth_first_traverse(const graph_t *graph, void (*action)(const vertex_t *v, size_t depth))
 {
-	int *visited = NULL;
+	unsigned char *visited = NULL;
 	size_t max_depth = 0;
-	size_t i;
 
 	if (graph == NULL || action == NULL || graph->vertices == NULL)
 		return (0);
 
 	/* Allocate and initialize visited array */
-	visited = malloc(sizeof(int) * graph->nb_vertices);
+	visited = calloc(graph->nb_slots, sizeof(*visited));
 	if (visited == NULL)
 		return (0);
 
-	for (i = 0; i < graph->nb_vertices; i++)
-		visited[i] = 0;
-
-	dfs_recursive(graph->vertices, visited, 0, action, &max_depth);
+	max_depth = dfs_iterative(graph, visited, action);
 
 	free(visited);
-	return (max_depth);
-}
\ No newline at end of file
+	return (max_depth == (size_t)-1 ? 0 : max_depth);
+}
@@ -0,0 +1,34 @@
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#include <stddef.h>
+
+/**
+ * struct bench_edges_s - Synthetic graph, as a list of edges between
+ * vertex ids
+ * @nb_vertices: Number of vertices, with ids from 0 to @nb_vertices - 1
+ * @nb_edges: Number of edges in @pairs
+ * @pairs: Source and destination ids of each edge
+ */
+typedef struct bench_edges_s
+{
+	size_t nb_vertices;
+	size_t nb_edges;
+	size_t (*pairs)[2];
+} bench_edges_t;
+
+/* Synthetic graphs */
+bench_edges_t *bench_generate(const char *kind, size_t nb_vertices,
+							  size_t degree, unsigned int seed);
+void bench_edges_delete(bench_edges_t *edges);
+
+/* Allocation counters, filled when linked with -Wl,--wrap=malloc,... */
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void *__wrap_malloc(size_t size);
+void *__wrap_calloc(size_t nmemb, size_t size);
+void *__wrap_realloc(void *ptr, size_t size);
+void bench_alloc_count(size_t *nb_allocs, size_t *nb_bytes);
+
+#endif /* _BENCH_H_ */
@@ -0,0 +1,69 @@
+#include <stdlib.h>
+#include "bench.h"
+
+/*
+ * Allocation counters of the graphs benchmark. Linking with
+ *   -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc
+ * routes every allocation of the graphs module through the wrappers
+ * below, which count them before handing them to the C library.
+ */
+
+/**
+ * alloc_counters - Gives access to the allocation counters.
+ * Return: The number of allocations, then the number of bytes requested.
+ */
+static size_t *alloc_counters(void)
+{
+	static size_t counters[2];
+
+	return (counters);
+}
+
+/**
+ * __wrap_malloc - Counts a call to malloc.
+ * @size: Number of bytes requested.
+ * Return: What malloc returns.
+ */
+void *__wrap_malloc(size_t size)
+{
+	__atomic_fetch_add(&alloc_counters()[0], 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&alloc_counters()[1], size, __ATOMIC_RELAXED);
+	return (__real_malloc(size));
+}
+
+/**
+ * __wrap_calloc - Counts a call to calloc.
+ * @nmemb: Number of elements requested.
+ * @size: Size of an element.
+ * Return: What calloc returns.
+ */
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+	__atomic_fetch_add(&alloc_counters()[0], 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&alloc_counters()[1], nmemb * size, __ATOMIC_RELAXED);
+	return (__real_calloc(nmemb, size));
+}
+
+/**
+ * __wrap_realloc - Counts a call to realloc.
+ * @ptr: The memory to resize.
+ * @size: Number of bytes requested.
+ * Return: What realloc returns.
+ */
+void *__wrap_realloc(void *ptr, size_t size)
+{
+	__atomic_fetch_add(&alloc_counters()[0], 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&alloc_counters()[1], size, __ATOMIC_RELAXED);
+	return (__real_realloc(ptr, size));
+}
+
+/**
+ * bench_alloc_count - Reads the allocation counters.
+ * @nb_allocs: Receives the number of allocations so far.
+ * @nb_bytes: Receives the number of bytes requested so far.
+ */
+void bench_alloc_count(size_t *nb_allocs, size_t *nb_bytes)
+{
+	*nb_allocs = __atomic_load_n(&alloc_counters()[0], __ATOMIC_RELAXED);
+	*nb_bytes = __atomic_load_n(&alloc_counters()[1], __ATOMIC_RELAXED);
+}
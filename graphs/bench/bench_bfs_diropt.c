@@ -0,0 +1,144 @@
+/*
+ * Benchmark of the direction-optimizing BFS against the top-down one, on
+ * a power-law (R-MAT) graph with a small diameter.
+ *
+ * Build and run from the graphs directory:
+ *   gcc -O2 -Wall -Werror -Wextra -pedantic -I. bench/bench_bfs_diropt.c \
+ *       *.c -pthread -o bench_bfs_diropt
+ *   ./bench_bfs_diropt [scale] [edge_factor] [runs]
+ *
+ * Prints one "key=value" line per traversal mode.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "graphs.h"
+
+/**
+ * now - Reads a monotonic clock.
+ * Return: The current time in seconds.
+ */
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((double)ts.tv_sec + (double)ts.tv_nsec / 1e9);
+}
+
+/**
+ * rmat_vertex - Picks one endpoint of an R-MAT edge, descending the
+ * adjacency matrix quadrant by quadrant (a = 0.57, b = c = 0.19).
+ * @scale: Log2 of the number of vertices.
+ * @row: 1 to pick the row (source), 0 to pick the column (destination).
+ * @draws: Random draws, one per level, shared by both endpoints.
+ * Return: The vertex id.
+ */
+static size_t rmat_vertex(int scale, int row, const int *draws)
+{
+	size_t id = 0;
+	int i;
+
+	for (i = 0; i < scale; i++)
+	{
+		id <<= 1;
+		if (row && draws[i] >= 76)
+			id |= 1; /* Quadrants c and d */
+		else if (!row && draws[i] >= 57 && (draws[i] < 76 || draws[i] >= 95))
+			id |= 1; /* Quadrants b and d */
+	}
+	return (id);
+}
+
+/**
+ * build_rmat - Builds a bidirectional R-MAT graph.
+ * @scale: Log2 of the number of vertices.
+ * @edge_factor: Number of edges drawn per vertex.
+ * Return: A pointer to the graph, or NULL on failure.
+ */
+static graph_t *build_rmat(int scale, int edge_factor)
+{
+	size_t nb_v = (size_t)1 << scale, i, e;
+	vertex_t **ids;
+	graph_t *graph;
+	int draws[64], k;
+	char name[24];
+
+	graph = graph_create_arena(0);
+	ids = malloc(sizeof(*ids) * nb_v);
+	if (graph == NULL || ids == NULL || !graph_index_reserve(graph, nb_v))
+	{
+		free(ids);
+		graph_delete(graph);
+		return (NULL);
+	}
+	for (i = 0; i < nb_v; i++)
+	{
+		sprintf(name, "%lu", (unsigned long)i);
+		ids[i] = graph_add_vertex(graph, name);
+	}
+	for (e = 0; e < nb_v * edge_factor; e++)
+	{
+		for (k = 0; k < scale; k++)
+			draws[k] = rand() % 100;
+		graph_link_vertices(graph, ids[rmat_vertex(scale, 1, draws)],
+							ids[rmat_vertex(scale, 0, draws)], BIDIRECTIONAL);
+	}
+	free(ids);
+	return (graph);
+}
+
+/**
+ * count - Traversal action that does nothing but be called.
+ * @v: The visited vertex.
+ * @depth: Its depth.
+ */
+static void count(const vertex_t *v, size_t depth)
+{
+	(void)v;
+	(void)depth;
+}
+
+/**
+ * main - Entry point.
+ * @ac: Number of arguments.
+ * @av: Arguments: scale, edge factor and number of runs.
+ * Return: 0 on success, 1 on failure.
+ */
+int main(int ac, char **av)
+{
+	int scale = ac > 1 ? atoi(av[1]) : 18, factor = ac > 2 ? atoi(av[2]) : 16;
+	int runs = ac > 3 ? atoi(av[3]) : 5, r;
+	size_t depth[2] = {0, 0};
+	double t[2] = {0, 0}, start;
+	graph_csr_t *csr;
+	graph_t *graph;
+
+	srand(1);
+	graph = build_rmat(scale, factor);
+	csr = graph_freeze(graph);
+	if (csr == NULL || !graph_csr_reverse(csr))
+	{
+		graph_csr_delete(csr);
+		graph_delete(graph);
+		return (1);
+	}
+	for (r = 0; r < runs; r++)
+	{
+		start = now();
+		depth[0] = csr_breadth_first_traverse(csr, count);
+		t[0] += now() - start;
+		start = now();
+		depth[1] = csr_breadth_first_traverse_diropt(csr, count);
+		t[1] += now() - start;
+	}
+	printf("mode=top_down vertices=%lu edges=%lu max_depth=%lu ns_per_edge=%.3f\n",
+		   (unsigned long)csr->nb_vertices, (unsigned long)csr->nb_edges,
+		   (unsigned long)depth[0], t[0] * 1e9 / runs / csr->nb_edges);
+	printf("mode=diropt vertices=%lu edges=%lu max_depth=%lu ns_per_edge=%.3f\n",
+		   (unsigned long)csr->nb_vertices, (unsigned long)csr->nb_edges,
+		   (unsigned long)depth[1], t[1] * 1e9 / runs / csr->nb_edges);
+	graph_csr_delete(csr);
+	graph_delete(graph);
+	return (0);
+}
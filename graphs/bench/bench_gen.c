@@ -0,0 +1,147 @@
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+/* Step of a xorshift64 generator: good enough, and the same everywhere */
+#define XORSHIFT(x) ((x) ^= (x) << 13, (x) ^= (x) >> 7, (x) ^= (x) << 17)
+
+/**
+ * gen_er - Draws an Erdős–Rényi G(n, m) graph: each edge joins two
+ * distinct vertices picked uniformly.
+ * @e: The graph, with nb_vertices set and room for @m edges.
+ * @m: Number of edges to draw.
+ * @seed: Random state.
+ */
+static void gen_er(bench_edges_t *e, size_t m, unsigned long long seed)
+{
+	size_t src, dest;
+
+	while (e->nb_edges < m && e->nb_vertices > 1)
+	{
+		src = XORSHIFT(seed) % e->nb_vertices;
+		dest = XORSHIFT(seed) % e->nb_vertices;
+		if (src == dest)
+			continue;
+		e->pairs[e->nb_edges][0] = src;
+		e->pairs[e->nb_edges++][1] = dest;
+	}
+}
+
+/**
+ * gen_rmat - Draws an R-MAT graph, whose degrees follow a power law: each
+ * edge descends the adjacency matrix quadrant by quadrant, with the
+ * probabilities a = 0.57, b = c = 0.19, d = 0.05. Self loops are dropped.
+ * @e: The graph, with nb_vertices set (a power of two) and room for @m
+ * edges.
+ * @m: Number of edges to draw.
+ * @seed: Random state.
+ */
+static void gen_rmat(bench_edges_t *e, size_t m, unsigned long long seed)
+{
+	size_t i, bit, src, dest;
+	unsigned int draw;
+
+	for (i = 0; i < m; i++)
+	{
+		src = dest = 0;
+		for (bit = 1; bit < e->nb_vertices; bit <<= 1)
+		{
+			draw = XORSHIFT(seed) % 100;
+			if (draw >= 76)
+				src |= bit; /* Quadrants c and d */
+			if (draw >= 57 && (draw < 76 || draw >= 95))
+				dest |= bit; /* Quadrants b and d */
+		}
+		if (src == dest)
+			continue;
+		e->pairs[e->nb_edges][0] = src;
+		e->pairs[e->nb_edges++][1] = dest;
+	}
+}
+
+/**
+ * gen_lattice - Builds a grid, each vertex linked to its right and lower
+ * neighbours. A grid of width 1 is a chain.
+ * @e: The graph, with nb_vertices set and room for 2 * nb_vertices edges.
+ * @width: Number of vertices per row.
+ */
+static void gen_lattice(bench_edges_t *e, size_t width)
+{
+	size_t v;
+
+	for (v = 0; v < e->nb_vertices; v++)
+	{
+		if (width > 1 && (v + 1) % width != 0 && v + 1 < e->nb_vertices)
+		{
+			e->pairs[e->nb_edges][0] = v;
+			e->pairs[e->nb_edges++][1] = v + 1;
+		}
+		if (v + width < e->nb_vertices)
+		{
+			e->pairs[e->nb_edges][0] = v;
+			e->pairs[e->nb_edges++][1] = v + width;
+		}
+	}
+}
+
+/**
+ * bench_generate - Generates a synthetic graph.
+ * @kind: "er" (Erdős–Rényi), "rmat" (power-law), "grid" (square grid)
+ * or "chain" (a single path).
+ * @nb_vertices: Number of vertices; rounded up to a power of two for
+ * "rmat", and down to a square for "grid".
+ * @degree: Average number of edges per vertex, counting both directions
+ * ("er" and "rmat" only).
+ * @seed: Seed of the random generator, for reproducible graphs.
+ * Return: A pointer to the graph, or NULL on failure.
+ */
+bench_edges_t *bench_generate(const char *kind, size_t nb_vertices,
+							  size_t degree, unsigned int seed)
+{
+	bench_edges_t *e;
+	size_t room, width = 1;
+	unsigned long long state = 0x9E3779B97F4A7C15ULL ^ seed;
+
+	e = calloc(1, sizeof(*e));
+	if (e == NULL)
+		return (NULL);
+	e->nb_vertices = nb_vertices;
+	if (strcmp(kind, "rmat") == 0)
+		for (e->nb_vertices = 1; e->nb_vertices < nb_vertices;)
+			e->nb_vertices <<= 1;
+	if (strcmp(kind, "grid") == 0)
+	{
+		while ((width + 1) * (width + 1) <= nb_vertices)
+			width++;
+		e->nb_vertices = width * width;
+	}
+	room = e->nb_vertices * (degree > 4 ? degree : 4) / 2 + 1;
+	e->pairs = malloc(sizeof(*e->pairs) * room);
+	if (e->pairs == NULL)
+	{
+		free(e);
+		return (NULL);
+	}
+	if (strcmp(kind, "er") == 0)
+		gen_er(e, e->nb_vertices * degree / 2, state);
+	else if (strcmp(kind, "rmat") == 0)
+		gen_rmat(e, e->nb_vertices * degree / 2, state);
+	else if (strcmp(kind, "grid") == 0 || strcmp(kind, "chain") == 0)
+		gen_lattice(e, width);
+	else
+		bench_edges_delete(e), e = NULL;
+	return (e);
+}
+
+/**
+ * bench_edges_delete - Deletes a synthetic graph.
+ * @edges: Pointer to the graph.
+ */
+void bench_edges_delete(bench_edges_t *edges)
+{
+	if (edges == NULL)
+		return;
+
+	free(edges->pairs);
+	free(edges);
+}
@@ -0,0 +1,200 @@
+/*
+ * Benchmark of the graphs module on synthetic graphs: Erdős–Rényi,
+ * R-MAT (power-law), square grid and long chain. Times the creation of
+ * the graph through graph_add_vertex/graph_add_edge, each traversal, and
+ * the deletion, and counts the allocations made by each phase.
+ *
+ * Build and run from the graphs directory:
+ *   gcc -O2 -Wall -Werror -Wextra -pedantic -I. -Ibench \
+ *       bench/bench_graphs.c bench/bench_gen.c bench/bench_alloc.c *.c \
+ *       -pthread -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc \
+ *       -o bench_graphs
+ *   ./bench_graphs [graph] [nb_vertices] [degree] [seed] [arena]
+ *
+ * graph is er, rmat, grid, chain or all (the default); arena is 1 to
+ * build arena-backed graphs. Prints one "key=value" line per graph and
+ * phase. ns_per_edge divides the phase's time by the number of edges of
+ * the graph (a BIDIRECTIONAL edge counts twice); peak_rss_kb is the
+ * high-water mark of the process so far.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "graphs.h"
+#include "bench.h"
+
+#define NAME_SIZE 24 /* Room for the name of a vertex */
+
+/**
+ * struct bench_run_s - State of the benchmark of one graph
+ * @edges: The synthetic graph
+ * @names: Names of the vertices, NAME_SIZE bytes each, by id
+ * @arena: 1 to build an arena-backed graph
+ * @graph: The graph, once created
+ * @csr: Its frozen snapshot, once frozen
+ * @depth: Biggest vertex depth found by the last phase, 0 if it is not a
+ * traversal
+ */
+typedef struct bench_run_s
+{
+	bench_edges_t *edges;
+	char *names;
+	int arena;
+	graph_t *graph;
+	graph_csr_t *csr;
+	size_t depth;
+} bench_run_t;
+
+static const char *const phases[] = {
+	"create", "dfs", "bfs", "bfs_diropt", "bfs_parallel", "dfs_chunked",
+	"bfs_chunked", "freeze", "csr_dfs", "csr_bfs", "delete", NULL
+};
+
+/**
+ * now - Reads a monotonic clock.
+ * Return: The current time in seconds.
+ */
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((double)ts.tv_sec + (double)ts.tv_nsec / 1e9);
+}
+
+/**
+ * visit - Traversal action that does nothing but be called.
+ * @v: The visited vertex.
+ * @depth: Its depth.
+ */
+static void visit(const vertex_t *v, size_t depth)
+{
+	(void)v;
+	(void)depth;
+}
+
+/**
+ * visit_chunk - Chunked traversal action that does nothing but be called.
+ * @visits: The visits.
+ * @nb_visits: Number of visits.
+ * @arg: Unused.
+ */
+static void visit_chunk(const graph_visit_t *visits, size_t nb_visits,
+						void *arg)
+{
+	(void)visits;
+	(void)nb_visits;
+	(void)arg;
+}
+
+/**
+ * run_phase - Runs one phase of the benchmark.
+ * @run: Pointer to the state of the benchmark.
+ * @phase: Index of the phase in phases.
+ * Return: 1 on success, 0 on failure.
+ */
+static int run_phase(bench_run_t *run, size_t phase)
+{
+	const bench_edges_t *e = run->edges;
+	size_t i;
+
+	run->depth = 0;
+	switch (phase)
+	{
+	case 0:
+		run->graph = run->arena ? graph_create_arena(0) : graph_create();
+		for (i = 0; run->graph && i < e->nb_vertices; i++)
+			if (!graph_add_vertex(run->graph, run->names + i * NAME_SIZE))
+				return (0);
+		for (i = 0; run->graph && i < e->nb_edges; i++)
+			if (!graph_add_edge(run->graph, run->names + e->pairs[i][0] * NAME_SIZE,
+								run->names + e->pairs[i][1] * NAME_SIZE, BIDIRECTIONAL))
+				return (0);
+		return (run->graph != NULL);
+	case 1:
+		run->depth = depth_first_traverse(run->graph, visit);
+		break;
+	case 2:
+		run->depth = breadth_first_traverse(run->graph, visit);
+		break;
+	case 3:
+		run->depth = breadth_first_traverse_diropt(run->graph, visit);
+		break;
+	case 4:
+		run->depth = breadth_first_traverse_parallel(run->graph, visit, 0);
+		break;
+	case 5:
+		run->depth = depth_first_traverse_chunked(run->graph, visit_chunk, NULL, 0);
+		break;
+	case 6:
+		run->depth = breadth_first_traverse_chunked(run->graph, visit_chunk, NULL, 0);
+		break;
+	case 7:
+		run->csr = graph_freeze(run->graph);
+		return (run->csr != NULL);
+	case 8:
+		run->depth = csr_depth_first_traverse(run->csr, visit);
+		break;
+	case 9:
+		run->depth = csr_breadth_first_traverse(run->csr, visit);
+		break;
+	default:
+		graph_csr_delete(run->csr), graph_delete(run->graph);
+		run->csr = NULL, run->graph = NULL;
+	}
+	return (1);
+}
+
+/**
+ * main - Entry point.
+ * @ac: Number of arguments.
+ * @av: Arguments: graph kind, number of vertices, degree, seed and arena.
+ * Return: 0 on success, 1 on failure.
+ */
+int main(int ac, char **av)
+{
+	static const char *const kinds[] = {"er", "rmat", "grid", "chain", NULL};
+	const char *kind = ac > 1 ? av[1] : "all";
+	size_t n = ac > 2 ? strtoul(av[2], NULL, 10) : 1 << 20;
+	size_t degree = ac > 3 ? strtoul(av[3], NULL, 10) : 8, k, p, i;
+	size_t allocs[2], bytes[2], nb_edges = 0;
+	bench_run_t run = {NULL, NULL, 0, NULL, NULL, 0};
+	struct rusage usage;
+	double start, t;
+	graph_stats_t stats;
+
+	run.arena = ac > 5 && atoi(av[5]);
+	for (k = 0; kinds[k] != NULL; k++)
+	{
+		if (strcmp(kind, "all") != 0 && strcmp(kind, kinds[k]) != 0)
+			continue;
+		run.edges = bench_generate(kinds[k], n, degree, ac > 4 ? atoi(av[4]) : 1);
+		run.names = run.edges ? malloc(NAME_SIZE * run.edges->nb_vertices) : NULL;
+		if (run.names == NULL)
+			return (bench_edges_delete(run.edges), 1);
+		for (i = 0; i < run.edges->nb_vertices; i++)
+			sprintf(run.names + i * NAME_SIZE, "%lu", (unsigned long)i);
+		for (p = 0; phases[p] != NULL; p++)
+		{
+			bench_alloc_count(&allocs[0], &bytes[0]);
+			start = now();
+			if (!run_phase(&run, p))
+				return (fprintf(stderr, "%s: %s failed\n", kinds[k], phases[p]), 1);
+			t = now() - start;
+			bench_alloc_count(&allocs[1], &bytes[1]);
+			getrusage(RUSAGE_SELF, &usage);
+			if (p == 0 && graph_stats(run.graph, &stats))
+				nb_edges = stats.nb_edges ? stats.nb_edges : 1;
+			printf("graph=%s phase=%s vertices=%lu edges=%lu max_depth=%lu seconds=%.6f ns_per_edge=%.3f allocs=%lu alloc_bytes=%lu peak_rss_kb=%ld\n",
+				   kinds[k], phases[p], (unsigned long)run.edges->nb_vertices,
+				   (unsigned long)nb_edges, (unsigned long)run.depth, t,
+				   t * 1e9 / nb_edges,
+				   (unsigned long)(allocs[1] - allocs[0]),
+				   (unsigned long)(bytes[1] - bytes[0]), usage.ru_maxrss);
+		}
+		free(run.names), bench_edges_delete(run.edges);
+	}
+	return (0);
+}
@@ -0,0 +1,154 @@
+#include <stdlib.h>
+#include <string.h>
+#include "graphs.h"
+
+/**
+ * struct batch_s - State of a batched traversal. Bit s of a vertex's masks
+ * stands for the traversal started from sources[s]
+ * @seen: Per vertex index, the traversals that already reached it
+ * @visit: Per vertex index, the traversals it is in the frontier of
+ * @next: Per vertex index, the traversals it is in the next frontier of
+ * @frontier: The vertices whose @visit mask is set
+ * @nb_frontier: Number of vertices in @frontier
+ * @found: The vertices whose @next mask is set
+ * @nb_found: Number of vertices in @found
+ * @nb_slots: Number of vertex indices of the graph (row length of @depths)
+ * @depths: Depth matrix to fill (nb_sources rows), or NULL
+ * @action: Function to call for each (vertex, source) reached, or NULL
+ */
+typedef struct batch_s
+{
+	uint64_t *seen;
+	uint64_t *visit;
+	uint64_t *next;
+	const vertex_t **frontier;
+	size_t nb_frontier;
+	const vertex_t **found;
+	size_t nb_found;
+	size_t nb_slots;
+	size_t *depths;
+	void (*action)(const vertex_t *v, size_t source, size_t depth);
+} batch_t;
+
+/**
+ * report - Records that some traversals reached a vertex at a given depth.
+ * @st: Pointer to the traversal state.
+ * @vertex: The vertex reached.
+ * @mask: The traversals that reached it.
+ * @depth: Its depth in each of those traversals.
+ */
+static void report(batch_t *st, const vertex_t *vertex, uint64_t mask,
+				   size_t depth)
+{
+	size_t s;
+
+	for (s = 0; mask != 0; s++, mask >>= 1)
+	{
+		if (!(mask & 1))
+			continue;
+		if (st->depths != NULL)
+			st->depths[s * st->nb_slots + vertex->index] = depth;
+		if (st->action != NULL)
+			st->action(vertex, s, depth);
+	}
+}
+
+/**
+ * batch_level - Expands the frontiers of every traversal by one level,
+ * in a single pass over the adjacency lists of the vertices they hold.
+ * @st: Pointer to the traversal state.
+ * @depth: Depth of the vertices found by this level.
+ * Return: 1 if any traversal found new vertices, 0 otherwise.
+ */
+static int batch_level(batch_t *st, size_t depth)
+{
+	const vertex_t *v, **tmp_list;
+	const edge_t *edge;
+	uint64_t found, *tmp;
+	size_t i;
+
+	st->nb_found = 0;
+	for (i = 0; i < st->nb_frontier; i++)
+	{
+		v = st->frontier[i];
+		for (edge = v->edges; edge != NULL; edge = edge->next)
+		{
+			found = st->visit[v->index] & ~st->seen[edge->dest->index];
+			if (found == 0)
+				continue;
+			if (st->next[edge->dest->index] == 0)
+				st->found[st->nb_found++] = edge->dest;
+			st->next[edge->dest->index] |= found;
+			st->seen[edge->dest->index] |= found;
+			report(st, edge->dest, found, depth);
+		}
+	}
+	for (i = 0; i < st->nb_frontier; i++)
+		st->visit[st->frontier[i]->index] = 0;
+	tmp = st->visit, st->visit = st->next, st->next = tmp;
+	tmp_list = st->frontier, st->frontier = st->found, st->found = tmp_list;
+	st->nb_frontier = st->nb_found;
+	return (st->nb_frontier > 0);
+}
+
+/**
+ * breadth_first_traverse_batch - Runs up to GRAPH_BATCH_MAX breadth-first
+ * traversals at once, sharing a single pass over the adjacency lists per
+ * level: each vertex carries one bit per traversal in its masks. Each
+ * level only goes through the vertices in some traversal's frontier.
+ * @graph: Pointer to the graph to traverse.
+ * @sources: The starting vertex of each traversal.
+ * @nb_sources: Number of traversals, at most GRAPH_BATCH_MAX.
+ * @depths: Matrix of nb_sources rows of graph->nb_slots entries, or NULL.
+ * depths[s * graph->nb_slots + v->index] receives the depth of v from
+ * sources[s], or GRAPH_DEPTH_NONE if v cannot be reached from it.
+ * @action: Function to call for each vertex reached by a traversal, or NULL.
+ * v -> A const pointer to the vertex.
+ * source -> The position of the traversal's source in @sources.
+ * depth -> The depth of v, from that source.
+ * Return: The biggest vertex depth over all traversals, or 0 on failure.
+ */
+size_t breadth_first_traverse_batch(const graph_t *graph, const vertex_t *const *sources, size_t nb_sources, size_t *depths, void (*action)(const vertex_t *v, size_t source, size_t depth))
+{
+	batch_t st;
+	size_t depth = 0, i;
+
+	if (graph == NULL || sources == NULL || nb_sources == 0 ||
+		nb_sources > GRAPH_BATCH_MAX)
+		return (0);
+	for (i = 0; i < nb_sources; i++)
+		if (sources[i] == NULL)
+			return (0);
+
+	st.nb_slots = graph->nb_slots;
+	st.depths = depths;
+	st.action = action;
+	st.seen = calloc(st.nb_slots * 3, sizeof(*st.seen));
+	st.frontier = malloc(sizeof(*st.frontier) * 2 * graph->nb_vertices);
+	if (st.seen == NULL || st.frontier == NULL)
+	{
+		free(st.seen), free(st.frontier);
+		return (0);
+	}
+	st.visit = st.seen + st.nb_slots;
+	st.next = st.visit + st.nb_slots;
+	st.found = st.frontier + graph->nb_vertices;
+	st.nb_frontier = 0;
+
+	for (i = 0; depths != NULL && i < nb_sources * st.nb_slots; i++)
+		depths[i] = GRAPH_DEPTH_NONE;
+	for (i = 0; i < nb_sources; i++)
+	{
+		if (st.visit[sources[i]->index] == 0)
+			st.frontier[st.nb_frontier++] = sources[i];
+		st.seen[sources[i]->index] |= (uint64_t)1 << i;
+		st.visit[sources[i]->index] |= (uint64_t)1 << i;
+		report(&st, sources[i], (uint64_t)1 << i, 0);
+	}
+	while (batch_level(&st, depth + 1))
+		depth++;
+
+	/* Starts of the blocks: @visit and @next, @frontier and @found swap */
+	free(st.seen), free(st.frontier < st.found ? st.frontier : st.found);
+	return (depth);
+}
@@ -0,0 +1,107 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/**
+ * struct bfs_chunk_s - Buffer of visits not handed to the action yet
+ * @visits: The visits
+ * @len: Number of visits in @visits
+ * @chunk: Number of visits handed at once
+ * @action: The action to hand the visits to
+ * @arg: Argument passed to @action
+ */
+typedef struct bfs_chunk_s
+{
+	graph_visit_t *visits;
+	size_t len;
+	size_t chunk;
+	void (*action)(const graph_visit_t *visits, size_t nb_visits, void *arg);
+	void *arg;
+} bfs_chunk_t;
+
+/**
+ * bfs_chunked_levels - Helper function for breadth_first_traverse_chunked.
+ * Same walk as breadth_first_traverse, each level being copied from the
+ * queue into the visit buffer as it is processed.
+ * @graph: Pointer to the graph to traverse.
+ * @queue: The queue array (nb_vertices slots).
+ * @visited: Bit-packed set of the vertices already enqueued.
+ * @buf: The visit buffer.
+ * Return: The biggest vertex depth.
+ */
+static size_t bfs_chunked_levels(const graph_t *graph, const vertex_t **queue,
+								 unsigned long *visited, bfs_chunk_t *buf)
+{
+	size_t head = 0, tail = 0, level_end, depth = 0;
+	const edge_t *edge;
+
+	queue[tail++] = graph->vertices;
+	GRAPH_BIT_SET(visited, graph->vertices->index);
+	while (head < tail)
+	{
+		for (level_end = tail; head < level_end; head++)
+		{
+			buf->visits[buf->len].vertex = queue[head];
+			buf->visits[buf->len].depth = depth;
+			if (++buf->len == buf->chunk)
+			{
+				buf->action(buf->visits, buf->len, buf->arg);
+				buf->len = 0;
+			}
+			for (edge = queue[head]->edges; edge != NULL; edge = edge->next)
+			{
+				if (!GRAPH_BIT_TEST(visited, edge->dest->index))
+				{
+					GRAPH_BIT_SET(visited, edge->dest->index);
+					queue[tail++] = edge->dest;
+				}
+			}
+		}
+		if (head < tail)
+			depth++;
+	}
+	if (buf->len > 0)
+		buf->action(buf->visits, buf->len, buf->arg);
+	return (depth);
+}
+
+/**
+ * breadth_first_traverse_chunked - Goes through a graph using the
+ * breadth-first algorithm, handing the visited vertices to the action in
+ * arrays rather than one call per vertex. Vertices are visited in the same
+ * order and at the same depth as with breadth_first_traverse.
+ * @graph: Pointer to the graph to traverse. The traversal must start from
+ * the first vertex in the vertices list.
+ * @action: Pointer to a function to be called for each batch of visits.
+ * visits -> The visited vertices and their depths, in visit order. The
+ * array is reused for the next batch once the action returns.
+ * nb_visits -> Number of visits, @chunk for every batch but the last.
+ * arg -> @arg.
+ * @arg: Argument passed to @action.
+ * @chunk: Number of visits per batch, or 0 for GRAPH_VISIT_CHUNK.
+ * Return: The biggest vertex depth, or 0 on failure.
+ */
+size_t breadth_first_traverse_chunked(const graph_t *graph, void (*action)(const graph_visit_t *visits, size_t nb_visits, void *arg), void *arg, size_t chunk)
+{
+	unsigned long *visited;
+	const vertex_t **queue;
+	bfs_chunk_t buf;
+	size_t max_depth = 0;
+
+	if (graph == NULL || action == NULL || graph->vertices == NULL)
+		return (0);
+
+	buf.chunk = chunk ? chunk : GRAPH_VISIT_CHUNK;
+	if (buf.chunk > graph->nb_vertices)
+		buf.chunk = graph->nb_vertices;
+	buf.len = 0;
+	buf.action = action;
+	buf.arg = arg;
+	buf.visits = malloc(sizeof(*buf.visits) * buf.chunk);
+	queue = malloc(sizeof(*queue) * graph->nb_vertices);
+	visited = calloc(GRAPH_BITS_SIZE(graph->nb_slots), sizeof(*visited));
+	if (buf.visits != NULL && queue != NULL && visited != NULL)
+		max_depth = bfs_chunked_levels(graph, queue, visited, &buf);
+
+	free(buf.visits), free(queue), free(visited);
+	return (max_depth);
+}
@@ -0,0 +1,208 @@
+#include <stdlib.h>
+#include <string.h>
+#include "graphs.h"
+
+/*
+ * Switching heuristics of Beamer et al.: go bottom-up once the frontier's
+ * edges outnumber DIROPT_ALPHA-th of the edges left to explore, and back
+ * top-down once the frontier shrinks under DIROPT_BETA-th of the vertices
+ */
+#define DIROPT_ALPHA 14
+#define DIROPT_BETA 24
+
+/**
+ * struct diropt_s - State of a direction-optimizing traversal.
+ * The queue holds the vertex indices level after level: the current
+ * frontier is queue[head] to queue[tail - 1], and the next level is
+ * appended after it.
+ * @queue: Vertex indices in visit order (nb_vertices)
+ * @head: Start of the current frontier in @queue
+ * @tail: End of the vertices enqueued so far in @queue
+ * @visited: Bit-packed set of the vertices already enqueued
+ * @frontier: Bit-packed set of the current frontier (bottom-up steps only)
+ * @unexplored: Number of edges leaving vertices not enqueued yet
+ */
+typedef struct diropt_s
+{
+	uint32_t *queue;
+	size_t head;
+	size_t tail;
+	unsigned long *visited;
+	unsigned long *frontier;
+	size_t unexplored;
+} diropt_t;
+
+/**
+ * top_down_step - Expands the frontier by following its outgoing edges.
+ * @csr: Pointer to the snapshot.
+ * @st: Pointer to the traversal state.
+ */
+static void top_down_step(const graph_csr_t *csr, diropt_t *st)
+{
+	size_t i, k, end = st->tail, v;
+
+	for (i = st->head; i < end; i++)
+	{
+		for (k = csr->offsets[st->queue[i]];
+			 k < csr->offsets[st->queue[i] + 1]; k++)
+		{
+			v = csr->targets[k];
+			if (!GRAPH_BIT_TEST(st->visited, v))
+			{
+				GRAPH_BIT_SET(st->visited, v);
+				st->queue[st->tail++] = (uint32_t)v;
+				st->unexplored -= csr->offsets[v + 1] - csr->offsets[v];
+			}
+		}
+	}
+}
+
+/**
+ * bottom_up_step - Expands the frontier by having every unvisited vertex
+ * look for a parent in the frontier among its incoming edges, stopping at
+ * the first one found. New vertices are enqueued in index order.
+ * @csr: Pointer to the snapshot, with its reverse adjacency.
+ * @st: Pointer to the traversal state.
+ */
+static void bottom_up_step(const graph_csr_t *csr, diropt_t *st)
+{
+	size_t v, k, i, nb_words = GRAPH_BITS_SIZE(csr->nb_vertices);
+
+	memset(st->frontier, 0, nb_words * sizeof(*st->frontier));
+	for (i = st->head; i < st->tail; i++)
+		GRAPH_BIT_SET(st->frontier, st->queue[i]);
+
+	for (v = 0; v < csr->nb_vertices; v++)
+	{
+		if (st->visited[v / GRAPH_BITS_WORD] == ~0UL)
+		{
+			v |= GRAPH_BITS_WORD - 1; /* Whole word already visited */
+			continue;
+		}
+		if (GRAPH_BIT_TEST(st->visited, v))
+			continue;
+		for (k = csr->rev_offsets[v]; k < csr->rev_offsets[v + 1]; k++)
+		{
+			if (GRAPH_BIT_TEST(st->frontier, csr->rev_sources[k]))
+			{
+				GRAPH_BIT_SET(st->visited, v);
+				st->queue[st->tail++] = (uint32_t)v;
+				st->unexplored -= csr->offsets[v + 1] - csr->offsets[v];
+				break;
+			}
+		}
+	}
+}
+
+/**
+ * diropt_levels - Runs the traversal level by level, choosing the
+ * direction of each step from the size of the frontier.
+ * @csr: Pointer to the snapshot.
+ * @st: Pointer to the traversal state, with the root enqueued.
+ * @action: The action function to call for each visited vertex.
+ * Return: The biggest vertex depth.
+ */
+static size_t diropt_levels(const graph_csr_t *csr, diropt_t *st,
+							void (*action)(const vertex_t *v, size_t depth))
+{
+	size_t depth = 0, level_end, frontier_edges, i;
+	int bottom_up = 0;
+
+	while (1)
+	{
+		frontier_edges = 0;
+		for (i = st->head; i < st->tail; i++)
+		{
+			action(csr->vertices[st->queue[i]], depth);
+			frontier_edges += csr->offsets[st->queue[i] + 1] -
+				csr->offsets[st->queue[i]];
+		}
+		if (!bottom_up && csr->rev_offsets != NULL &&
+			frontier_edges > st->unexplored / DIROPT_ALPHA)
+			bottom_up = 1;
+		else if (bottom_up &&
+				 st->tail - st->head < csr->nb_vertices / DIROPT_BETA)
+			bottom_up = 0;
+
+		level_end = st->tail;
+		if (bottom_up)
+			bottom_up_step(csr, st);
+		else
+			top_down_step(csr, st);
+		st->head = level_end;
+		if (st->head == st->tail)
+			return (depth);
+		depth++;
+	}
+}
+
+/**
+ * csr_breadth_first_traverse_diropt - Goes through a frozen graph using
+ * the direction-optimizing breadth-first algorithm: levels with a large
+ * frontier are expanded bottom-up, from the unvisited vertices, which
+ * skips most edges leading to already visited vertices.
+ * Depths and the returned maximum depth are the same as with
+ * breadth_first_traverse, but vertices found bottom-up are visited in
+ * index order within their level. Without the reverse adjacency (see
+ * graph_csr_reverse) every level is expanded top-down.
+ * @csr: Pointer to the snapshot to traverse. The traversal starts from
+ * the first vertex of the graph's vertices list.
+ * @action: Pointer to a function to be called for each visited vertex.
+ * v -> A const pointer to the visited vertex.
+ * depth -> The depth of v, from the starting vertex.
+ * Return: The biggest vertex depth, or 0 on failure.
+ */
+size_t csr_breadth_first_traverse_diropt(const graph_csr_t *csr, void (*action)(const vertex_t *v, size_t depth))
+{
+	diropt_t st;
+	size_t nb_words, max_depth;
+
+	if (csr == NULL || action == NULL || csr->root == GRAPH_ROOT_NONE)
+		return (0);
+
+	nb_words = GRAPH_BITS_SIZE(csr->nb_vertices);
+	st.queue = malloc(sizeof(*st.queue) * csr->nb_vertices);
+	st.visited = calloc(nb_words, sizeof(*st.visited));
+	st.frontier = malloc(sizeof(*st.frontier) * nb_words);
+	if (st.queue == NULL || st.visited == NULL || st.frontier == NULL)
+	{
+		free(st.queue), free(st.visited), free(st.frontier);
+		return (0);
+	}
+
+	st.head = 0;
+	st.tail = 1;
+	st.queue[0] = (uint32_t)csr->root;
+	GRAPH_BIT_SET(st.visited, csr->root);
+	st.unexplored = csr->nb_edges -
+		(csr->offsets[csr->root + 1] - csr->offsets[csr->root]);
+	max_depth = diropt_levels(csr, &st, action);
+
+	free(st.queue), free(st.visited), free(st.frontier);
+	return (max_depth);
+}
+
+/**
+ * breadth_first_traverse_diropt - Goes through a graph using the
+ * direction-optimizing breadth-first algorithm, on a frozen snapshot with
+ * its reverse adjacency built for the occasion. Callers traversing the
+ * same graph repeatedly should freeze it once and call
+ * csr_breadth_first_traverse_diropt instead.
+ * @graph: Pointer to the graph to traverse. The traversal must start from
+ * the first vertex in the vertices list.
+ * @action: Pointer to a function to be called for each visited vertex.
+ * v -> A const pointer to the visited vertex.
+ * depth -> The depth of v, from the starting vertex.
+ * Return: The biggest vertex depth, or 0 on failure.
+ */
+size_t breadth_first_traverse_diropt(const graph_t *graph, void (*action)(const vertex_t *v, size_t depth))
+{
+	graph_csr_t *csr;
+	size_t max_depth = 0;
+
+	csr = graph_freeze(graph);
+	if (csr != NULL && graph_csr_reverse(csr))
+		max_depth = csr_breadth_first_traverse_diropt(csr, action);
+	graph_csr_delete(csr);
+	return (max_depth);
+}
@@ -0,0 +1,189 @@
+#include <stdlib.h>
+#include <string.h>
+#include "graphs.h"
+
+#define PBFS_CHUNK 64 /* Frontier vertices claimed at once by a thread */
+
+/**
+ * struct pbfs_local_s - Next-level vertices found by one thread
+ * @items: The vertices
+ * @len: Number of vertices in @items
+ * @cap: Number of slots allocated in @items
+ */
+typedef struct pbfs_local_s
+{
+	const vertex_t **items;
+	size_t len;
+	size_t cap;
+} pbfs_local_t;
+
+/**
+ * struct pbfs_s - State shared by the threads of a parallel traversal
+ * @action: The action function to call for each visited vertex
+ * @frontier: Vertices of the current level (room for nb_vertices)
+ * @frontier_len: Number of vertices of the current level
+ * @cursor: Next frontier position to be claimed by a thread
+ * @depth: Depth of the current level
+ * @visited: Bit-packed set of the vertices already claimed
+ * @locals: Next-level vertices found by each thread
+ * @failed: Set when a thread could not grow its local frontier
+ */
+typedef struct pbfs_s
+{
+	void (*action)(const vertex_t *v, size_t depth);
+	const vertex_t **frontier;
+	size_t frontier_len;
+	size_t cursor;
+	size_t depth;
+	unsigned long *visited;
+	pbfs_local_t *locals;
+	int failed;
+} pbfs_t;
+
+/**
+ * claim - Atomically marks a vertex as visited.
+ * A plain load first spares the atomic operation on vertices that are
+ * already visited, which most edges lead to.
+ * @visited: Bit-packed set of the vertices already claimed.
+ * @index: Index of the vertex.
+ * Return: 1 if the calling thread claimed the vertex, 0 if it was visited.
+ */
+static int claim(unsigned long *visited, size_t index)
+{
+	unsigned long *word = &visited[index / GRAPH_BITS_WORD];
+	unsigned long bit = 1UL << (index % GRAPH_BITS_WORD);
+
+	if (__atomic_load_n(word, __ATOMIC_RELAXED) & bit)
+		return (0);
+	return (!(__atomic_fetch_or(word, bit, __ATOMIC_RELAXED) & bit));
+}
+
+/**
+ * pbfs_level - Task run by every thread for one level: claims chunks of
+ * the frontier, reports their vertices and claims their unvisited
+ * neighbors into the thread's local next frontier.
+ * @arg: Pointer to the shared state.
+ * @thread_id: Id of the calling thread.
+ */
+static void pbfs_level(void *arg, size_t thread_id)
+{
+	pbfs_t *st = arg;
+	pbfs_local_t *local = &st->locals[thread_id];
+	const vertex_t **grown;
+	size_t i, end;
+	edge_t *edge;
+
+	while ((i = __atomic_fetch_add(&st->cursor, PBFS_CHUNK,
+								   __ATOMIC_RELAXED)) < st->frontier_len)
+	{
+		end = i + PBFS_CHUNK < st->frontier_len ? i + PBFS_CHUNK :
+			st->frontier_len;
+		for (; i < end; i++)
+		{
+			st->action(st->frontier[i], st->depth);
+			for (edge = st->frontier[i]->edges; edge; edge = edge->next)
+			{
+				if (!claim(st->visited, edge->dest->index))
+					continue;
+				if (local->len == local->cap)
+				{
+					grown = realloc(local->items, sizeof(*grown) *
+									(local->cap ? local->cap * 2 : PBFS_CHUNK));
+					if (grown == NULL)
+					{
+						__atomic_store_n(&st->failed, 1, __ATOMIC_RELAXED);
+						return;
+					}
+					local->items = grown;
+					local->cap = local->cap ? local->cap * 2 : PBFS_CHUNK;
+				}
+				local->items[local->len++] = edge->dest;
+			}
+		}
+	}
+}
+
+/**
+ * pbfs_levels - Runs the traversal level by level on a pool, merging the
+ * threads' local frontiers into the next frontier between two levels.
+ * @pool: Pointer to the pool of threads.
+ * @st: Pointer to the shared state, with the first level in the frontier.
+ * @nb_threads: Number of threads of the pool.
+ * Return: The biggest vertex depth, or (size_t)-1 on failure.
+ */
+static size_t pbfs_levels(graph_pool_t *pool, pbfs_t *st, size_t nb_threads)
+{
+	size_t t;
+
+	while (1)
+	{
+		st->cursor = 0;
+		graph_pool_run(pool, pbfs_level, st);
+		if (st->failed)
+			return ((size_t)-1);
+
+		st->frontier_len = 0;
+		for (t = 0; t < nb_threads; t++)
+		{
+			if (st->locals[t].len == 0)
+				continue;
+			memcpy(st->frontier + st->frontier_len, st->locals[t].items,
+				   sizeof(*st->frontier) * st->locals[t].len);
+			st->frontier_len += st->locals[t].len;
+			st->locals[t].len = 0;
+		}
+		if (st->frontier_len == 0)
+			return (st->depth);
+		st->depth++;
+	}
+}
+
+/**
+ * breadth_first_traverse_parallel - Goes through a graph using a
+ * level-synchronous breadth-first algorithm spread over several threads.
+ * Each level of the traversal is split across the threads, which claim
+ * vertices with an atomic operation on a shared visited set, and the
+ * next-level vertices they find are merged once the level is done.
+ * Depths and the returned maximum depth are the same as with
+ * breadth_first_traverse.
+ * @graph: Pointer to the graph to traverse. The traversal must start from
+ * the first vertex in the vertices list.
+ * @action: Pointer to a function to be called for each visited vertex.
+ * v -> A const pointer to the visited vertex.
+ * depth -> The depth of v, from the starting vertex.
+ * The action is called exactly once per reachable vertex, concurrently
+ * from up to @nb_threads threads, so it must be thread-safe. Every vertex
+ * of a given depth is reported before any vertex of the next depth, in no
+ * particular order within a depth.
+ * @nb_threads: Number of threads to use, or 0 for one per processor.
+ * Return: The biggest vertex depth, or 0 on failure.
+ */
+size_t breadth_first_traverse_parallel(const graph_t *graph, void (*action)(const vertex_t *v, size_t depth), size_t nb_threads)
+{
+	graph_pool_t *pool;
+	pbfs_t st;
+	size_t max_depth = (size_t)-1, t;
+
+	if (graph == NULL || action == NULL || graph->vertices == NULL)
+		return (0);
+
+	memset(&st, 0, sizeof(st));
+	st.action = action;
+	pool = graph_pool_create(&nb_threads);
+	st.frontier = malloc(sizeof(*st.frontier) * graph->nb_vertices);
+	st.visited = calloc(GRAPH_BITS_SIZE(graph->nb_slots),
+						sizeof(*st.visited));
+	st.locals = calloc(nb_threads, sizeof(*st.locals));
+	if (pool != NULL && st.frontier && st.visited && st.locals)
+	{
+		st.frontier[st.frontier_len++] = graph->vertices;
+		GRAPH_BIT_SET(st.visited, graph->vertices->index);
+		max_depth = pbfs_levels(pool, &st, nb_threads);
+	}
+
+	graph_pool_delete(pool);
+	for (t = 0; st.locals != NULL && t < nb_threads; t++)
+		free(st.locals[t].items);
+	free(st.locals), free(st.visited), free(st.frontier);
+	return (max_depth == (size_t)-1 ? 0 : max_depth);
+}
@@ -0,0 +1,74 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/**
+ * bfs_walk_enqueue - Marks a vertex visited and appends it to the queue.
+ * @walk: Pointer to the walk state.
+ * @tail: Pointer to the end of the queue.
+ * @vertex: The vertex to enqueue.
+ * Return: 1 on success, 0 on failure.
+ */
+static int bfs_walk_enqueue(graph_walk_t *walk, size_t *tail,
+							const vertex_t *vertex)
+{
+	if (*tail == walk->size && !graph_walk_grow(walk))
+		return (0);
+	walk->marks[vertex->index] = walk->epoch;
+	walk->stack[(*tail)++] = vertex;
+	return (1);
+}
+
+/**
+ * breadth_first_walk - Goes through the part of a graph within a given
+ * depth of a vertex, using the breadth-first algorithm, until the action
+ * stops it. Vertices are visited in the same order and at the same depth
+ * as with breadth_first_traverse started from @start. Only the vertices
+ * visited and their edges are touched: the visited set and the queue are
+ * kept in @walk from one walk to the next.
+ * @graph: Pointer to the graph to go through.
+ * @walk: Pointer to the walk state (see graph_walk_create).
+ * @start: The vertex to start from.
+ * @max_depth: Depth past which vertices are not visited, or
+ * GRAPH_DEPTH_NONE to go through every vertex reachable from @start.
+ * @action: Pointer to a function to be called for each visited vertex.
+ * v -> A const pointer to the visited vertex.
+ * depth -> The depth of v, from @start.
+ * arg -> @arg.
+ * It returns GRAPH_WALK_CONTINUE, GRAPH_WALK_SKIP to not follow the edges
+ * of v, or GRAPH_WALK_STOP to end the walk (walk->stopped is then set).
+ * @arg: Argument passed to @action.
+ * Return: The biggest vertex depth, or 0 on failure.
+ */
+size_t breadth_first_walk(const graph_t *graph, graph_walk_t *walk, const vertex_t *start, size_t max_depth, graph_walk_action_t (*action)(const vertex_t *v, size_t depth, void *arg), void *arg)
+{
+	size_t head = 0, tail = 0, level_end, depth = 0;
+	graph_walk_action_t next;
+	const edge_t *edge;
+
+	if (graph == NULL || walk == NULL || start == NULL || action == NULL ||
+		!graph_walk_begin(walk, graph) || !bfs_walk_enqueue(walk, &tail, start))
+		return (0);
+
+	for (level_end = tail; head < tail; depth++, level_end = tail)
+	{
+		for (; head < level_end; head++)
+		{
+			walk->nb_visited++;
+			next = action(walk->stack[head], depth, arg);
+			if (next == GRAPH_WALK_STOP)
+			{
+				walk->stopped = 1;
+				return (depth);
+			}
+			if (next == GRAPH_WALK_SKIP || depth == max_depth)
+				continue;
+			for (edge = walk->stack[head]->edges; edge; edge = edge->next)
+				if (walk->marks[edge->dest->index] != walk->epoch &&
+					!bfs_walk_enqueue(walk, &tail, edge->dest))
+					return (0);
+		}
+		if (head == tail)
+			break;
+	}
+	return (depth);
+}
@@ -0,0 +1,57 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/**
+ * csr_breadth_first_traverse - Goes through a frozen graph using the
+ * breadth-first algorithm. The queue is a single array of vertex indices
+ * processed one level at a time, so no depth is stored per entry.
+ * Vertices are visited in the same order as breadth_first_traverse.
+ * @csr: Pointer to the snapshot to traverse. The traversal starts from
+ * the first vertex of the graph's vertices list.
+ * @action: Pointer to a function to be called for each visited vertex.
+ * v -> A const pointer to the visited vertex.
+ * depth -> The depth of v, from the starting vertex.
+ * Return: The biggest vertex depth, or 0 on failure.
+ */
+size_t csr_breadth_first_traverse(const graph_csr_t *csr, void (*action)(const vertex_t *v, size_t depth))
+{
+	uint32_t *queue;
+	unsigned char *visited;
+	size_t head = 0, tail = 0, level_end, depth = 0, u, i;
+
+	if (csr == NULL || action == NULL || csr->root == GRAPH_ROOT_NONE)
+		return (0);
+
+	visited = calloc(csr->nb_vertices, sizeof(*visited));
+	queue = malloc(sizeof(*queue) * csr->nb_vertices);
+	if (visited == NULL || queue == NULL)
+	{
+		free(visited), free(queue);
+		return (0);
+	}
+
+	visited[csr->root] = 1;
+	queue[tail++] = (uint32_t)csr->root;
+	level_end = tail;
+	while (head < tail)
+	{
+		if (head == level_end)
+		{
+			depth++;
+			level_end = tail;
+		}
+		u = queue[head++];
+		action(csr->vertices[u], depth);
+		for (i = csr->offsets[u]; i < csr->offsets[u + 1]; i++)
+		{
+			if (!visited[csr->targets[i]])
+			{
+				visited[csr->targets[i]] = 1;
+				queue[tail++] = csr->targets[i];
+			}
+		}
+	}
+
+	free(visited), free(queue);
+	return (depth);
+}
@@ -0,0 +1,69 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/**
+ * struct csr_frame_s - Frame of the explicit depth-first stack.
+ * @vertex: Index of the vertex being explored.
+ * @cursor: Position in the targets array of the next edge to follow.
+ */
+typedef struct csr_frame_s
+{
+	size_t vertex;
+	size_t cursor;
+} csr_frame_t;
+
+/**
+ * csr_depth_first_traverse - Goes through a frozen graph using the
+ * depth-first algorithm, with an explicit stack instead of recursion.
+ * Vertices are visited in the same order as depth_first_traverse.
+ * @csr: Pointer to the snapshot to traverse. The traversal starts from
+ * the first vertex of the graph's vertices list.
+ * @action: Pointer to a function to be called for each visited vertex.
+ * v -> A const pointer to the visited vertex.
+ * depth -> The depth of v, from the starting vertex.
+ * Return: The biggest vertex depth, or 0 on failure.
+ */
+size_t csr_depth_first_traverse(const graph_csr_t *csr, void (*action)(const vertex_t *v, size_t depth))
+{
+	csr_frame_t *stack, *top;
+	unsigned char *visited;
+	size_t depth = 0, max_depth = 0, dest;
+
+	if (csr == NULL || action == NULL || csr->root == GRAPH_ROOT_NONE)
+		return (0);
+
+	visited = calloc(csr->nb_vertices, sizeof(*visited));
+	stack = malloc(sizeof(*stack) * csr->nb_vertices);
+	if (visited == NULL || stack == NULL)
+	{
+		free(visited), free(stack);
+		return (0);
+	}
+
+	visited[csr->root] = 1;
+	action(csr->vertices[csr->root], 0);
+	stack[0].vertex = csr->root;
+	stack[0].cursor = csr->offsets[csr->root];
+	while (1)
+	{
+		top = &stack[depth];
+		if (top->cursor == csr->offsets[top->vertex + 1])
+		{
+			if (depth-- == 0)
+				break;
+			continue;
+		}
+		dest = csr->targets[top->cursor++];
+		if (visited[dest])
+			continue;
+		visited[dest] = 1;
+		action(csr->vertices[dest], ++depth);
+		if (depth > max_depth)
+			max_depth = depth;
+		stack[depth].vertex = dest;
+		stack[depth].cursor = csr->offsets[dest];
+	}
+
+	free(visited), free(stack);
+	return (max_depth);
+}
@@ -0,0 +1,153 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+#define DFS_STACK_MIN 64 /* Initial number of frames of the stack */
+
+/**
+ * struct dfs_chunk_s - State of a chunked depth-first traversal
+ * @stack: Explicit stack of the vertices being explored, by depth
+ * @edges: Next edge to follow of each vertex of @stack
+ * @size: Number of frames allocated in @stack and @edges
+ * @visits: Visits not handed to the action yet
+ * @len: Number of visits in @visits
+ * @chunk: Number of visits handed at once
+ * @action: The action to hand the visits to
+ * @arg: Argument passed to @action
+ */
+typedef struct dfs_chunk_s
+{
+	const vertex_t **stack;
+	const edge_t **edges;
+	size_t size;
+	graph_visit_t *visits;
+	size_t len;
+	size_t chunk;
+	void (*action)(const graph_visit_t *visits, size_t nb_visits, void *arg);
+	void *arg;
+} dfs_chunk_t;
+
+/**
+ * dfs_chunk_visit - Records a visit, handing the buffer to the action
+ * once it is full, and pushes the vertex on the stack, growing it up to
+ * the number of vertices when needed.
+ * @st: Pointer to the traversal state.
+ * @vertex: The visited vertex.
+ * @depth: Its depth, i.e. the frame to fill.
+ * @nb_vertices: Number of vertices in the graph.
+ * Return: 1 on success, 0 on failure.
+ */
+static int dfs_chunk_visit(dfs_chunk_t *st, const vertex_t *vertex,
+						   size_t depth, size_t nb_vertices)
+{
+	const vertex_t **stack;
+	const edge_t **edges;
+	size_t size;
+
+	st->visits[st->len].vertex = vertex;
+	st->visits[st->len].depth = depth;
+	if (++st->len == st->chunk)
+	{
+		st->action(st->visits, st->len, st->arg);
+		st->len = 0;
+	}
+	if (depth == st->size)
+	{
+		size = st->size * 2 < nb_vertices ? st->size * 2 : nb_vertices;
+		stack = realloc(st->stack, sizeof(*stack) * size);
+		if (stack != NULL)
+			st->stack = stack;
+		edges = realloc(st->edges, sizeof(*edges) * size);
+		if (edges != NULL)
+			st->edges = edges;
+		if (stack == NULL || edges == NULL)
+			return (0);
+		st->size = size;
+	}
+	st->stack[depth] = vertex;
+	st->edges[depth] = vertex->edges;
+	return (1);
+}
+
+/**
+ * dfs_chunked_walk - Helper function for depth_first_traverse_chunked.
+ * Same walk as depth_first_traverse.
+ * @graph: Pointer to the graph to traverse.
+ * @st: Pointer to the traversal state.
+ * @visited: An array to keep track of visited vertices.
+ * Return: The maximum depth found, or (size_t)-1 on allocation failure.
+ */
+static size_t dfs_chunked_walk(const graph_t *graph, dfs_chunk_t *st,
+							   unsigned char *visited)
+{
+	size_t depth = 0, max_depth = 0;
+	const vertex_t *dest;
+
+	visited[graph->vertices->index] = 1;
+	if (!dfs_chunk_visit(st, graph->vertices, 0, graph->nb_vertices))
+		return ((size_t)-1);
+	while (1)
+	{
+		if (st->edges[depth] == NULL)
+		{
+			if (depth-- == 0)
+				break;
+			continue;
+		}
+		dest = st->edges[depth]->dest;
+		st->edges[depth] = st->edges[depth]->next;
+		if (visited[dest->index])
+			continue;
+		visited[dest->index] = 1;
+		if (++depth > max_depth)
+			max_depth = depth;
+		if (!dfs_chunk_visit(st, dest, depth, graph->nb_vertices))
+			return ((size_t)-1);
+	}
+	if (st->len > 0)
+		st->action(st->visits, st->len, st->arg);
+	return (max_depth);
+}
+
+/**
+ * depth_first_traverse_chunked - Goes through a graph using the
+ * depth-first algorithm, handing the visited vertices to the action in
+ * arrays rather than one call per vertex. Vertices are visited in the same
+ * order and at the same depth as with depth_first_traverse.
+ * @graph: Pointer to the graph to traverse. The traversal must start from
+ * the first vertex in the vertices list.
+ * @action: Pointer to a function to be called for each batch of visits.
+ * visits -> The visited vertices and their depths, in visit order. The
+ * array is reused for the next batch once the action returns.
+ * nb_visits -> Number of visits, @chunk for every batch but the last.
+ * arg -> @arg.
+ * @arg: Argument passed to @action.
+ * @chunk: Number of visits per batch, or 0 for GRAPH_VISIT_CHUNK.
+ * Return: The biggest vertex depth, or 0 on failure.
+ */
+size_t depth_first_traverse_chunked(const graph_t *graph, void (*action)(const graph_visit_t *visits, size_t nb_visits, void *arg), void *arg, size_t chunk)
+{
+	unsigned char *visited;
+	dfs_chunk_t st;
+	size_t max_depth = (size_t)-1;
+
+	if (graph == NULL || action == NULL || graph->vertices == NULL)
+		return (0);
+
+	st.chunk = chunk ? chunk : GRAPH_VISIT_CHUNK;
+	if (st.chunk > graph->nb_vertices)
+		st.chunk = graph->nb_vertices;
+	st.size = graph->nb_vertices < DFS_STACK_MIN ? graph->nb_vertices :
+		DFS_STACK_MIN;
+	st.len = 0;
+	st.action = action;
+	st.arg = arg;
+	st.visits = malloc(sizeof(*st.visits) * st.chunk);
+	st.stack = malloc(sizeof(*st.stack) * st.size);
+	st.edges = malloc(sizeof(*st.edges) * st.size);
+	visited = calloc(graph->nb_slots, sizeof(*visited));
+	if (st.visits && st.stack && st.edges && visited)
+		max_depth = dfs_chunked_walk(graph, &st, visited);
+
+	free(st.visits), free(st.stack), free(st.edges), free(visited);
+	return (max_depth == (size_t)-1 ? 0 : max_depth);
+}
@@ -0,0 +1,96 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/**
+ * dfs_walk_visit - Visits a vertex: marks it, calls the action and pushes
+ * the vertex on the stack unless its edges are not to be followed.
+ * @walk: Pointer to the walk state.
+ * @vertex: The vertex to visit.
+ * @depth: Its depth, i.e. the stack entry to fill.
+ * @max_depth: Depth whose vertices are not followed.
+ * @action: The action function to call for the vertex.
+ * @arg: Argument passed to @action.
+ * Return: 1 if the vertex was pushed, 0 if not, -1 if the walk must end
+ * (stopped by the action, or allocation failure).
+ */
+static int dfs_walk_visit(graph_walk_t *walk, const vertex_t *vertex,
+						  size_t depth, size_t max_depth,
+						  graph_walk_action_t (*action)(const vertex_t *v,
+														size_t depth,
+														void *arg),
+						  void *arg)
+{
+	graph_walk_action_t next;
+
+	walk->marks[vertex->index] = walk->epoch;
+	walk->nb_visited++;
+	next = action(vertex, depth, arg);
+	if (next == GRAPH_WALK_STOP)
+	{
+		walk->stopped = 1;
+		return (-1);
+	}
+	if (next == GRAPH_WALK_SKIP || depth == max_depth)
+		return (0);
+	if (depth == walk->size && !graph_walk_grow(walk))
+		return (-1);
+	walk->stack[depth] = vertex;
+	walk->edges[depth] = vertex->edges;
+	return (1);
+}
+
+/**
+ * depth_first_walk - Goes through the part of a graph within a given
+ * depth of a vertex, using the depth-first algorithm, until the action
+ * stops it. Vertices are visited in the same order and at the same depth
+ * as with depth_first_traverse started from @start, bar the ones only
+ * reachable through a vertex past @max_depth. Only the vertices visited
+ * and their edges are touched: the visited set and the stack are kept in
+ * @walk from one walk to the next.
+ * @graph: Pointer to the graph to go through.
+ * @walk: Pointer to the walk state (see graph_walk_create).
+ * @start: The vertex to start from.
+ * @max_depth: Depth past which vertices are not visited, or
+ * GRAPH_DEPTH_NONE to go through every vertex reachable from @start.
+ * @action: Pointer to a function to be called for each visited vertex.
+ * v -> A const pointer to the visited vertex.
+ * depth -> The depth of v, from @start.
+ * arg -> @arg.
+ * It returns GRAPH_WALK_CONTINUE, GRAPH_WALK_SKIP to not follow the edges
+ * of v, or GRAPH_WALK_STOP to end the walk (walk->stopped is then set).
+ * @arg: Argument passed to @action.
+ * Return: The biggest vertex depth, or 0 on failure.
+ */
+size_t depth_first_walk(const graph_t *graph, graph_walk_t *walk, const vertex_t *start, size_t max_depth, graph_walk_action_t (*action)(const vertex_t *v, size_t depth, void *arg), void *arg)
+{
+	size_t nb_frames, max_seen = 0;
+	const edge_t *edge;
+	int pushed;
+
+	if (graph == NULL || walk == NULL || start == NULL || action == NULL ||
+		!graph_walk_begin(walk, graph))
+		return (0);
+
+	/* The vertex at depth d is walk->stack[d], and its edges lead to depth d + 1 */
+	pushed = dfs_walk_visit(walk, start, 0, max_depth, action, arg);
+	for (nb_frames = pushed > 0 ? 1 : 0; nb_frames > 0;)
+	{
+		edge = walk->edges[nb_frames - 1];
+		if (edge == NULL)
+		{
+			nb_frames--;
+			continue;
+		}
+		walk->edges[nb_frames - 1] = edge->next;
+		if (walk->marks[edge->dest->index] == walk->epoch)
+			continue;
+		if (nb_frames > max_seen)
+			max_seen = nb_frames;
+		pushed = dfs_walk_visit(walk, edge->dest, nb_frames, max_depth,
+								action, arg);
+		if (pushed < 0)
+			break;
+		nb_frames += pushed;
+	}
+	return (pushed < 0 && !walk->stopped ? 0 : max_seen);
+}
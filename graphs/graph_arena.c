@@ -0,0 +1,113 @@
+#include <stdlib.h>
+#include <string.h>
+#include "graphs.h"
+
+/**
+ * arena_alloc - Hands out a block of memory from an arena.
+ * Blocks bigger than a regular slab get a dedicated slab, linked behind
+ * the one being filled so that the remaining space is not lost.
+ * @arena: Pointer to the arena.
+ * @size: Number of bytes needed.
+ * @align: Required alignment (a power of two, at most GRAPH_ARENA_ALIGN).
+ * Return: A pointer to the block, or NULL on failure.
+ */
+static void *arena_alloc(graph_arena_t *arena, size_t size, size_t align)
+{
+	graph_slab_t *slab = arena->slabs;
+	size_t offset, slab_size;
+
+	if (slab != NULL)
+	{
+		offset = (slab->used + align - 1) & ~(align - 1);
+		if (offset <= slab->size && size <= slab->size - offset)
+		{
+			slab->used = offset + size;
+			return ((char *)slab + GRAPH_SLAB_HEADER + offset);
+		}
+	}
+
+	slab_size = size > arena->slab_size ? size : arena->slab_size;
+	slab = malloc(GRAPH_SLAB_HEADER + slab_size);
+	if (slab == NULL)
+		return (NULL);
+	slab->size = slab_size;
+	slab->used = size;
+	if (size > arena->slab_size && arena->slabs != NULL)
+	{
+		slab->next = arena->slabs->next;
+		arena->slabs->next = slab;
+	}
+	else
+	{
+		slab->next = arena->slabs;
+		arena->slabs = slab;
+	}
+	return ((char *)slab + GRAPH_SLAB_HEADER);
+}
+
+/**
+ * graph_alloc - Allocates memory for a node (vertex, edge, ...) of a graph,
+ * from its arena if it has one.
+ * @graph: Pointer to the graph the node belongs to.
+ * @size: Number of bytes needed.
+ * Return: A pointer to the allocated memory, or NULL on failure.
+ */
+void *graph_alloc(graph_t *graph, size_t size)
+{
+	if (graph->arena == NULL)
+		return (malloc(size));
+	return (arena_alloc(graph->arena, size, GRAPH_ARENA_ALIGN));
+}
+
+/**
+ * graph_strdup - Duplicates a content string for a graph, packing it in
+ * its arena if it has one.
+ * @graph: Pointer to the graph the string belongs to.
+ * @str: The string to duplicate.
+ * Return: A pointer to the copy, or NULL on failure.
+ */
+char *graph_strdup(graph_t *graph, const char *str)
+{
+	size_t len = strlen(str) + 1;
+	char *copy;
+
+	if (graph->arena == NULL)
+		copy = malloc(len);
+	else
+		copy = arena_alloc(graph->arena, len, 1);
+	if (copy == NULL)
+		return (NULL);
+	return (memcpy(copy, str, len));
+}
+
+/**
+ * graph_free - Releases memory obtained from graph_alloc or graph_strdup.
+ * Arena memory is only reclaimed when the whole graph is deleted.
+ * @graph: Pointer to the graph the memory belongs to.
+ * @ptr: The memory to release.
+ */
+void graph_free(graph_t *graph, void *ptr)
+{
+	if (graph->arena == NULL)
+		free(ptr);
+}
+
+/**
+ * graph_arena_delete - Releases every slab of an arena, and the arena.
+ * @arena: Pointer to the arena to delete.
+ */
+void graph_arena_delete(graph_arena_t *arena)
+{
+	graph_slab_t *slab;
+
+	if (arena == NULL)
+		return;
+
+	while (arena->slabs != NULL)
+	{
+		slab = arena->slabs;
+		arena->slabs = slab->next;
+		free(slab);
+	}
+	free(arena);
+}
@@ -0,0 +1,97 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/**
+ * uf_find - Finds the root of a vertex's set, halving the path to it.
+ * @parent: Parent of each vertex index in the union-find forest.
+ * @index: Index of the vertex.
+ * Return: Index of the root.
+ */
+static size_t uf_find(size_t *parent, size_t index)
+{
+	while (parent[index] != index)
+	{
+		parent[index] = parent[parent[index]];
+		index = parent[index];
+	}
+	return (index);
+}
+
+/**
+ * graph_components_relabel - Numbers components from 0, in the order their
+ * first vertex appears in the vertices list.
+ * @graph: Pointer to the graph.
+ * @roots: Per vertex index, the index of a vertex standing for its
+ * component, the same for every vertex of a component.
+ * @labels: Array of graph->nb_slots entries to fill, distinct from @roots.
+ * Indices no vertex holds are set to GRAPH_LABEL_NONE.
+ * Return: The number of components, or 0 on failure.
+ */
+size_t graph_components_relabel(const graph_t *graph, const size_t *roots,
+								size_t *labels)
+{
+	const vertex_t *v;
+	size_t *ids, i, nb = 0;
+
+	ids = malloc(sizeof(*ids) * (graph->nb_slots ? graph->nb_slots : 1));
+	if (ids == NULL)
+		return (0);
+	for (i = 0; i < graph->nb_slots; i++)
+		ids[i] = labels[i] = GRAPH_LABEL_NONE;
+
+	for (v = graph->vertices; v != NULL; v = v->next)
+	{
+		if (ids[roots[v->index]] == GRAPH_LABEL_NONE)
+			ids[roots[v->index]] = nb++;
+		labels[v->index] = ids[roots[v->index]];
+	}
+	free(ids);
+	return (nb);
+}
+
+/**
+ * graph_components - Labels the connected components of a graph, edges
+ * being followed both ways (weakly connected components, for graphs with
+ * UNIDIRECTIONAL edges), using a union-find forest. Runs in near-linear
+ * time in the number of vertices and edges.
+ * @graph: Pointer to the graph.
+ * @labels: Array of graph->nb_slots entries, receiving the component of
+ * each vertex by vertex_s::index. Components are numbered from 0, in the
+ * order their first vertex appears in the vertices list.
+ * Return: The number of components, or 0 on failure.
+ */
+size_t graph_components(const graph_t *graph, size_t *labels)
+{
+	const vertex_t *v;
+	const edge_t *edge;
+	size_t *parent, i, a, b, nb;
+
+	if (graph == NULL || labels == NULL || graph->vertices == NULL)
+		return (0);
+
+	parent = malloc(sizeof(*parent) * graph->nb_slots);
+	if (parent == NULL)
+		return (0);
+	for (i = 0; i < graph->nb_slots; i++)
+		parent[i] = i;
+
+	for (v = graph->vertices; v != NULL; v = v->next)
+	{
+		for (edge = v->edges; edge != NULL; edge = edge->next)
+		{
+			a = uf_find(parent, v->index);
+			b = uf_find(parent, edge->dest->index);
+			/* Link the higher root under the lower one */
+			if (a < b)
+				parent[b] = a;
+			else if (b < a)
+				parent[a] = b;
+		}
+	}
+	for (i = 0; i < graph->nb_slots; i++)
+		parent[i] = uf_find(parent, i);
+
+	nb = graph_components_relabel(graph, parent, labels);
+	free(parent);
+	return (nb);
+}
@@ -0,0 +1,123 @@
+#include <stdlib.h>
+#include <string.h>
+#include "graphs.h"
+
+#define LP_CHUNK 256 /* Vertex indices claimed at once by a thread */
+
+/**
+ * struct lp_s - State shared by the threads of a label propagation
+ * @csr: Frozen snapshot of the graph
+ * @roots: Per vertex index, the smallest index it is known to be
+ * connected to
+ * @cursor: Next vertex index to be claimed by a thread
+ * @changed: Set when a round lowered any entry of @roots
+ */
+typedef struct lp_s
+{
+	graph_csr_t *csr;
+	size_t *roots;
+	size_t cursor;
+	int changed;
+} lp_t;
+
+/**
+ * lower - Atomically lowers an entry of the roots array.
+ * @root: Pointer to the entry.
+ * @value: The value to lower it to.
+ * Return: 1 if the entry was lowered, 0 if it was already lower or equal.
+ */
+static int lower(size_t *root, size_t value)
+{
+	size_t cur = __atomic_load_n(root, __ATOMIC_RELAXED);
+
+	while (value < cur)
+		if (__atomic_compare_exchange_n(root, &cur, value, 1,
+										__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			return (1);
+	return (0);
+}
+
+/**
+ * lp_round - Task run by every thread for one round: claims chunks of
+ * vertex indices, shortcuts each vertex's root to its root's root, then
+ * gives both ends of each of its edges the smaller of their roots.
+ * @arg: Pointer to the shared state.
+ * @thread_id: Id of the calling thread.
+ */
+static void lp_round(void *arg, size_t thread_id)
+{
+	lp_t *st = arg;
+	size_t i, end, k, a, b, n = st->csr->nb_vertices;
+	int changed = 0;
+
+	(void)thread_id;
+	while ((i = __atomic_fetch_add(&st->cursor, LP_CHUNK,
+								   __ATOMIC_RELAXED)) < n)
+	{
+		end = i + LP_CHUNK < n ? i + LP_CHUNK : n;
+		for (; i < end; i++)
+		{
+			a = __atomic_load_n(&st->roots[i], __ATOMIC_RELAXED);
+			changed |= lower(&st->roots[i],
+							 __atomic_load_n(&st->roots[a], __ATOMIC_RELAXED));
+			for (k = st->csr->offsets[i]; k < st->csr->offsets[i + 1]; k++)
+			{
+				a = __atomic_load_n(&st->roots[i], __ATOMIC_RELAXED);
+				b = __atomic_load_n(&st->roots[st->csr->targets[k]],
+									__ATOMIC_RELAXED);
+				if (a < b)
+					changed |= lower(&st->roots[st->csr->targets[k]], a);
+				else if (b < a)
+					changed |= lower(&st->roots[i], b);
+			}
+		}
+	}
+	if (changed)
+		__atomic_store_n(&st->changed, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * graph_components_parallel - Labels the connected components of a graph
+ * like graph_components, by label propagation spread over several
+ * threads: every vertex starts with its own index as root, and rounds
+ * lower the roots along the edges, both ways, until none changes. The
+ * number of rounds grows with the diameter of the components, which
+ * suits the small-world graphs this is meant for.
+ * @graph: Pointer to the graph.
+ * @labels: Array of graph->nb_slots entries, receiving the component of
+ * each vertex by vertex_s::index. Labels are the same as with
+ * graph_components.
+ * @nb_threads: Number of threads to use, or 0 for one per processor.
+ * Return: The number of components, or 0 on failure.
+ */
+size_t graph_components_parallel(const graph_t *graph, size_t *labels,
+								 size_t nb_threads)
+{
+	graph_pool_t *pool;
+	lp_t st;
+	size_t i, nb = 0;
+
+	if (graph == NULL || labels == NULL || graph->vertices == NULL)
+		return (0);
+
+	memset(&st, 0, sizeof(st));
+	pool = graph_pool_create(&nb_threads);
+	st.csr = graph_freeze(graph);
+	st.roots = malloc(sizeof(*st.roots) * graph->nb_slots);
+	if (pool != NULL && st.csr != NULL && st.roots != NULL)
+	{
+		for (i = 0; i < graph->nb_slots; i++)
+			st.roots[i] = i;
+		do {
+			st.cursor = 0;
+			st.changed = 0;
+			graph_pool_run(pool, lp_round, &st);
+		} while (st.changed);
+		nb = graph_components_relabel(graph, st.roots, labels);
+	}
+
+	graph_pool_delete(pool);
+	graph_csr_delete(st.csr);
+	free(st.roots);
+	return (nb);
+}
@@ -0,0 +1,128 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graphs.h"
+
+/**
+ * graph_edge_slot - Computes the home slot of a destination vertex in an
+ * edge set.
+ * @dest: The destination vertex.
+ * @mask: Number of slots minus one.
+ * Return: The slot index.
+ */
+size_t graph_edge_slot(const vertex_t *dest, size_t mask)
+{
+	size_t h = (size_t)((uintptr_t)dest >> 4);
+
+	h ^= h >> 16;
+	h *= (size_t)0x45d9f3bu;
+	h ^= h >> 16;
+	return (h & mask);
+}
+
+/**
+ * place_edge - Stores an edge in the first free slot of its probe chain.
+ * @set: The slot array.
+ * @mask: Number of slots minus one.
+ * @edge: The edge to store.
+ */
+static void place_edge(edge_t **set, size_t mask, edge_t *edge)
+{
+	size_t i;
+
+	i = graph_edge_slot(edge->dest, mask);
+	while (set[i] != NULL)
+		i = (i + 1) & mask;
+	set[i] = edge;
+}
+
+/**
+ * rebuild_edge_set - Reallocates a vertex's edge set and refills it
+ * from its edge list.
+ * @graph: Pointer to the graph the vertex belongs to.
+ * @vertex: The vertex owning the set.
+ * @size: The new number of slots (a power of two).
+ * Return: 1 on success, 0 on failure.
+ */
+static int rebuild_edge_set(graph_t *graph, vertex_t *vertex, size_t size)
+{
+	edge_t **set;
+	edge_t *edge;
+
+	set = graph_alloc(graph, size * sizeof(*set));
+	if (set == NULL)
+		return (0);
+	memset(set, 0, size * sizeof(*set));
+
+	for (edge = vertex->edges; edge != NULL; edge = edge->next)
+		place_edge(set, size - 1, edge);
+
+	graph_free(graph, vertex->edge_set);
+	vertex->edge_set = set;
+	vertex->edge_set_size = size;
+	return (1);
+}
+
+/**
+ * graph_find_edge - Looks up the edge going from a vertex to another.
+ * Vertices whose degree reached GRAPH_EDGE_SET_THRESHOLD are looked up
+ * through their edge set, the others by walking their (short) edge list.
+ * @src: The source vertex.
+ * @dest: The destination vertex.
+ * Return: Pointer to the edge if found, NULL otherwise.
+ */
+edge_t *graph_find_edge(const vertex_t *src, const vertex_t *dest)
+{
+	edge_t *edge;
+	size_t mask, i;
+
+	if (src == NULL || dest == NULL)
+		return (NULL);
+
+	if (src->edge_set == NULL)
+	{
+		for (edge = src->edges; edge != NULL; edge = edge->next)
+			if (edge->dest == dest)
+				return (edge);
+		return (NULL);
+	}
+
+	mask = src->edge_set_size - 1;
+	i = graph_edge_slot(dest, mask);
+	while (src->edge_set[i] != NULL)
+	{
+		if (src->edge_set[i]->dest == dest)
+			return (src->edge_set[i]);
+		i = (i + 1) & mask;
+	}
+	return (NULL);
+}
+
+/**
+ * graph_edge_set_insert - Registers a new edge in its source's edge set,
+ * creating the set once the source's degree reaches the threshold.
+ * Must be called before the edge is linked and @nb_edges incremented.
+ * @graph: Pointer to the graph the vertex belongs to.
+ * @src: The source vertex of the edge.
+ * @edge: The new edge.
+ * Return: 1 on success, 0 on failure.
+ */
+int graph_edge_set_insert(graph_t *graph, vertex_t *src, edge_t *edge)
+{
+	size_t size;
+
+	if (src->edge_set == NULL && src->nb_edges + 1 < GRAPH_EDGE_SET_THRESHOLD)
+		return (1);
+
+	if ((src->nb_edges + 1) * 2 > src->edge_set_size)
+	{
+		size = src->edge_set_size ? src->edge_set_size :
+			GRAPH_EDGE_SET_THRESHOLD;
+		while ((src->nb_edges + 1) * 2 > size)
+			size *= 2;
+		if (!rebuild_edge_set(graph, src, size))
+			return (0);
+	}
+	place_edge(src->edge_set, src->edge_set_size - 1, edge);
+	return (1);
+}
@@ -0,0 +1,137 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/**
+ * graph_csr_delete - Deletes a frozen snapshot of a graph.
+ * The graph it was built from is left untouched.
+ * @csr: Pointer to the snapshot to delete.
+ */
+void graph_csr_delete(graph_csr_t *csr)
+{
+	if (csr == NULL)
+		return;
+
+	free(csr->offsets);
+	free(csr->targets);
+	free(csr->weights);
+	free(csr->vertices);
+	free(csr->rev_offsets);
+	free(csr->rev_sources);
+	free(csr);
+}
+
+/**
+ * csr_alloc - Allocates a snapshot and its arrays.
+ * @nb_vertices: Number of vertices to make room for.
+ * @nb_edges: Number of edges to make room for.
+ * Return: A pointer to the allocated snapshot, or NULL on failure.
+ */
+static graph_csr_t *csr_alloc(size_t nb_vertices, size_t nb_edges)
+{
+	graph_csr_t *csr;
+
+	csr = calloc(1, sizeof(*csr));
+	if (csr == NULL)
+		return (NULL);
+
+	csr->nb_vertices = nb_vertices;
+	csr->nb_edges = nb_edges;
+	csr->offsets = calloc(nb_vertices + 1, sizeof(*csr->offsets));
+	csr->targets = malloc(sizeof(*csr->targets) * (nb_edges ? nb_edges : 1));
+	csr->weights = malloc(sizeof(*csr->weights) * (nb_edges ? nb_edges : 1));
+	csr->vertices = calloc(nb_vertices ? nb_vertices : 1, sizeof(*csr->vertices));
+	if (csr->offsets == NULL || csr->targets == NULL ||
+		csr->weights == NULL || csr->vertices == NULL)
+	{
+		graph_csr_delete(csr);
+		return (NULL);
+	}
+	return (csr);
+}
+
+/**
+ * graph_freeze - Compacts a graph into a read-only compressed sparse row
+ * snapshot, indexed by vertex_s::index. The indices of removed vertices
+ * not reused yet are left empty.
+ * @graph: Pointer to the graph to freeze.
+ * Return: A pointer to the snapshot, or NULL on failure.
+ */
+graph_csr_t *graph_freeze(const graph_t *graph)
+{
+	graph_csr_t *csr;
+	const vertex_t *vertex;
+	const edge_t *edge;
+	size_t nb_edges = 0, i, pos;
+
+	if (graph == NULL || graph->nb_slots > UINT32_MAX)
+		return (NULL);
+
+	for (vertex = graph->vertices; vertex != NULL; vertex = vertex->next)
+		nb_edges += vertex->nb_edges;
+
+	csr = csr_alloc(graph->nb_slots, nb_edges);
+	if (csr == NULL)
+		return (NULL);
+
+	csr->root = graph->vertices ? graph->vertices->index : GRAPH_ROOT_NONE;
+	for (vertex = graph->vertices; vertex != NULL; vertex = vertex->next)
+	{
+		csr->vertices[vertex->index] = vertex;
+		csr->offsets[vertex->index + 1] = vertex->nb_edges;
+	}
+	for (i = 0; i < csr->nb_vertices; i++)
+		csr->offsets[i + 1] += csr->offsets[i];
+
+	for (i = 0; i < csr->nb_vertices; i++)
+	{
+		pos = csr->offsets[i];
+		edge = csr->vertices[i] ? csr->vertices[i]->edges : NULL;
+		for (; edge != NULL; edge = edge->next, pos++)
+		{
+			csr->targets[pos] = (uint32_t)edge->dest->index;
+			csr->weights[pos] = edge->weight;
+		}
+	}
+	return (csr);
+}
+
+/**
+ * graph_csr_reverse - Adds the reverse adjacency (incoming edges) to a
+ * frozen snapshot. The sources of each vertex's incoming edges are sorted
+ * by increasing index.
+ * @csr: Pointer to the snapshot.
+ * Return: 1 on success, 0 on failure.
+ */
+int graph_csr_reverse(graph_csr_t *csr)
+{
+	size_t *fill, i, k;
+
+	if (csr == NULL)
+		return (0);
+	if (csr->rev_offsets != NULL)
+		return (1);
+
+	csr->rev_offsets = calloc(csr->nb_vertices + 1, sizeof(*csr->rev_offsets));
+	csr->rev_sources = malloc(sizeof(*csr->rev_sources) *
+							  (csr->nb_edges ? csr->nb_edges : 1));
+	fill = malloc(sizeof(*fill) * (csr->nb_vertices ? csr->nb_vertices : 1));
+	if (csr->rev_offsets == NULL || csr->rev_sources == NULL || fill == NULL)
+	{
+		free(csr->rev_offsets), free(csr->rev_sources), free(fill);
+		csr->rev_offsets = NULL, csr->rev_sources = NULL;
+		return (0);
+	}
+
+	for (k = 0; k < csr->nb_edges; k++)
+		csr->rev_offsets[csr->targets[k] + 1]++;
+	for (i = 0; i < csr->nb_vertices; i++)
+	{
+		csr->rev_offsets[i + 1] += csr->rev_offsets[i];
+		fill[i] = csr->rev_offsets[i];
+	}
+	for (i = 0; i < csr->nb_vertices; i++)
+		for (k = csr->offsets[i]; k < csr->offsets[i + 1]; k++)
+			csr->rev_sources[fill[csr->targets[k]]++] = (uint32_t)i;
+	free(fill);
+	return (1);
+}
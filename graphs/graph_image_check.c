@@ -0,0 +1,159 @@
+#include <string.h>
+#include "graphs.h"
+
+/* Offset in the image of a pointer encoded for a mapping at its base */
+#define DECODE(img, p) ((uint64_t)(uintptr_t)(p) - (img)->base)
+
+/**
+ * vertex_at - Finds the vertex an encoded pointer of an image points to.
+ * @img: Header of the image.
+ * @map: The mapped image, not relocated yet.
+ * @p: The pointer, encoded for a mapping at the base of the image.
+ * Return: The vertex if @p is the address of a slot in use (one holding
+ * content and its own index), NULL otherwise.
+ */
+static const vertex_t *vertex_at(const graph_image_t *img, const char *map,
+								 const vertex_t *p)
+{
+	uint64_t off = DECODE(img, p) - img->vertices, i;
+	const vertex_t *v;
+
+	if (off % sizeof(vertex_t) != 0)
+		return (NULL);
+	i = off / sizeof(vertex_t);
+	if (i >= img->nb_slots)
+		return (NULL);
+	v = (const vertex_t *)(map + img->vertices) + i;
+	return (v->content != NULL && v->index == i ? v : NULL);
+}
+
+/**
+ * edge_at - Finds the edge an encoded pointer of an image points to.
+ * @img: Header of the image.
+ * @map: The mapped image, not relocated yet.
+ * @p: The pointer, encoded for a mapping at the base of the image.
+ * Return: The edge if @p is the address of an element of the edges
+ * array, NULL otherwise.
+ */
+static const edge_t *edge_at(const graph_image_t *img, const char *map,
+							 const edge_t *p)
+{
+	uint64_t off = DECODE(img, p) - img->edges;
+
+	if (off % sizeof(edge_t) != 0 || off / sizeof(edge_t) >= img->nb_edges)
+		return (NULL);
+	return ((const edge_t *)(map + img->edges) + off / sizeof(edge_t));
+}
+
+/**
+ * check_slot - Checks a vertex slot of an image. A slot in use holds its
+ * own index, content within the strings, no edge set nor incoming edges,
+ * and a list of exactly its number of edges, each leading to a slot in
+ * use, the last one being its tail. Any other slot is all zeros.
+ * @img: Header of the image.
+ * @map: The mapped image, not relocated yet.
+ * @i: Index of the slot.
+ * @nb_edges: Number of edges of the image not claimed by the slots
+ * checked so far, updated.
+ * Return: 1 if the slot is valid, 0 otherwise.
+ */
+static int check_slot(const graph_image_t *img, const char *map, uint64_t i,
+					  uint64_t *nb_edges)
+{
+	static const vertex_t zero;
+	const vertex_t *v = (const vertex_t *)(map + img->vertices) + i;
+	const edge_t *e = NULL, *p;
+	uint64_t n, content;
+
+	if (v->content == NULL)
+		return (memcmp(v, &zero, sizeof(zero)) == 0);
+	content = DECODE(img, v->content);
+	if (v->index != i || content < img->strings || content >= img->size ||
+		v->edge_set != NULL || v->edge_set_size != 0 ||
+		v->in_edges != NULL || v->nb_edges > *nb_edges)
+		return (0);
+	/* Bounded by the edges of the image, even if the list loops */
+	*nb_edges -= v->nb_edges;
+	for (n = 0, p = v->edges; n < v->nb_edges; n++, p = e->next)
+	{
+		e = edge_at(img, map, p);
+		if (e == NULL || vertex_at(img, map, e->dest) == NULL)
+			return (0);
+	}
+	if (n == 0)
+		return (v->edges == NULL && v->edges_tail == NULL);
+	return (e->next == NULL && edge_at(img, map, v->edges_tail) == e);
+}
+
+/**
+ * check_index - Checks the vertex list and the hash index of an image.
+ * The list runs through every slot in use once, with consistent @prev
+ * links, and the index is a power of two of buckets, at least one of
+ * them empty so that lookups end, referencing only slots in use.
+ * @img: Header of the image.
+ * @map: The mapped image, not relocated yet.
+ * @nb_used: Number of slots in use.
+ * Return: 1 if they are valid, 0 otherwise.
+ */
+static int check_index(const graph_image_t *img, const char *map,
+					   uint64_t nb_used)
+{
+	const graph_t *graph = (const graph_t *)(map + img->graph);
+	vertex_t *const *slot = (vertex_t *const *)(map + img->buckets);
+	const vertex_t *p = graph->vertices, *prev = NULL, *v;
+	uint64_t n, nb_full = 0;
+
+	if (graph->nb_vertices != nb_used)
+		return (0);
+	for (n = 0; n < nb_used; n++, prev = p, p = v->next)
+	{
+		v = vertex_at(img, map, p);
+		if (v == NULL || v->prev != prev)
+			return (0);
+	}
+	if (p != NULL || graph->vertices_tail != prev)
+		return (0);
+	for (n = 0; n < graph->nb_buckets; n++)
+	{
+		if (slot[n] != NULL && vertex_at(img, map, slot[n]) == NULL)
+			return (0);
+		nb_full += slot[n] != NULL;
+	}
+	if (graph->nb_buckets == 0)
+		return (nb_used == 0);
+	return (nb_full == nb_used && nb_full < graph->nb_buckets &&
+			(graph->nb_buckets & (graph->nb_buckets - 1)) == 0 &&
+			DECODE(img, graph->buckets) == img->buckets);
+}
+
+/**
+ * graph_image_check - Checks the contents of a mapped graph image before
+ * its pointers are used or relocated: every vertex, edge and bucket
+ * pointer must land on an element of its own array, every slot must be
+ * either in use or all zeros, and every content string must lie within
+ * the strings, which end with a NUL. Pointers are checked as encoded, so
+ * this holds whether the image is relocated or not.
+ * @img: Header of the image, already checked against the file (see
+ * graph_mmap_open), its arrays within the mapping.
+ * @map: The mapped image, not relocated yet.
+ * Return: 1 if the image is valid, 0 otherwise.
+ */
+int graph_image_check(const graph_image_t *img, const char *map)
+{
+	const graph_t *graph = (const graph_t *)(map + img->graph);
+	const vertex_t *v = (const vertex_t *)(map + img->vertices);
+	uint64_t i, nb_edges = img->nb_edges, nb_used = 0;
+
+	if (graph->nb_slots != img->nb_slots || graph->free_vertices != NULL ||
+		graph->track_in_edges || graph->arena != NULL ||
+		graph->mapping != NULL ||
+		(img->strings < img->size && map[img->size - 1] != '\0'))
+		return (0);
+	for (i = 0; i < img->nb_slots; i++)
+	{
+		if (!check_slot(img, map, i, &nb_edges))
+			return (0);
+		nb_used += v[i].content != NULL;
+	}
+	return (check_index(img, map, nb_used));
+}
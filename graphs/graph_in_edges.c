@@ -0,0 +1,106 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/**
+ * drop_in_edges - Frees the incoming edge lists of every vertex.
+ * @graph: Pointer to the graph.
+ */
+static void drop_in_edges(graph_t *graph)
+{
+	vertex_t *vertex;
+	edge_t *entry;
+
+	for (vertex = graph->vertices; vertex != NULL; vertex = vertex->next)
+	{
+		while (vertex->in_edges != NULL)
+		{
+			entry = vertex->in_edges;
+			vertex->in_edges = entry->next;
+			graph_free(graph, entry);
+		}
+	}
+}
+
+/**
+ * graph_track_in_edges - Builds the incoming edge list of every vertex,
+ * and has graph_link_vertices and graph_unlink_vertices maintain them
+ * from then on. Graphs that never remove a vertex do not pay for them.
+ * @graph: Pointer to the graph.
+ * Return: 1 on success, 0 on failure.
+ */
+int graph_track_in_edges(graph_t *graph)
+{
+	vertex_t *vertex;
+	edge_t *edge;
+
+	if (graph == NULL || graph->mapping != NULL)
+		return (0);
+	if (graph->track_in_edges)
+		return (1);
+
+	graph->track_in_edges = 1;
+	for (vertex = graph->vertices; vertex != NULL; vertex = vertex->next)
+	{
+		for (edge = vertex->edges; edge != NULL; edge = edge->next)
+		{
+			if (!graph_in_edge_insert(graph, vertex, edge))
+			{
+				drop_in_edges(graph);
+				graph->track_in_edges = 0;
+				return (0);
+			}
+		}
+	}
+	return (1);
+}
+
+/**
+ * graph_in_edge_insert - Records a new edge in its destination's incoming
+ * edge list, with its weight, if the graph tracks incoming edges.
+ * @graph: Pointer to the graph.
+ * @src: The source vertex of the edge.
+ * @edge: The edge.
+ * Return: 1 on success, 0 on failure.
+ */
+int graph_in_edge_insert(graph_t *graph, vertex_t *src, const edge_t *edge)
+{
+	edge_t *entry;
+
+	if (!graph->track_in_edges)
+		return (1);
+
+	entry = graph_alloc(graph, sizeof(*entry));
+	if (entry == NULL)
+		return (0);
+	entry->dest = src;
+	entry->weight = edge->weight;
+	entry->next = edge->dest->in_edges;
+	edge->dest->in_edges = entry;
+	return (1);
+}
+
+/**
+ * graph_in_edge_remove - Forgets an edge in its destination's incoming
+ * edge list, if the graph tracks incoming edges.
+ * @graph: Pointer to the graph.
+ * @dest: The destination vertex of the edge.
+ * @src: The source vertex of the edge.
+ */
+void graph_in_edge_remove(graph_t *graph, vertex_t *dest, const vertex_t *src)
+{
+	edge_t **link, *entry;
+
+	if (!graph->track_in_edges)
+		return;
+
+	for (link = &dest->in_edges; *link != NULL; link = &(*link)->next)
+	{
+		if ((*link)->dest == src)
+		{
+			entry = *link;
+			*link = entry->next;
+			graph_free(graph, entry);
+			return;
+		}
+	}
+}
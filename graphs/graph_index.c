@@ -0,0 +1,116 @@
+#include <stdlib.h>
+#include <string.h>
+#include "graphs.h"
+
+#define GRAPH_INDEX_MIN_BUCKETS 16
+
+/**
+ * graph_hash_string - Computes the FNV-1a hash of a string.
+ * @str: The string to hash.
+ * Return: The hash value.
+ */
+size_t graph_hash_string(const char *str)
+{
+	size_t hash = (size_t)2166136261u;
+
+	while (*str)
+	{
+		hash ^= (unsigned char)*str++;
+		hash *= (size_t)16777619u;
+	}
+	return (hash);
+}
+
+/**
+ * graph_find_vertex - Looks up a vertex by its content.
+ * @graph: Pointer to the graph.
+ * @str: The content string to search for.
+ * Return: Pointer to the vertex if found, NULL otherwise.
+ */
+vertex_t *graph_find_vertex(const graph_t *graph, const char *str)
+{
+	size_t mask, i;
+
+	if (graph == NULL || str == NULL || graph->nb_buckets == 0)
+		return (NULL);
+
+	mask = graph->nb_buckets - 1;
+	i = graph_hash_string(str) & mask;
+	while (graph->buckets[i] != NULL)
+	{
+		if (strcmp(graph->buckets[i]->content, str) == 0)
+			return (graph->buckets[i]);
+		i = (i + 1) & mask;
+	}
+	return (NULL);
+}
+
+/**
+ * place_vertex - Stores a vertex in the first free slot of its probe chain.
+ * @buckets: The slot array.
+ * @mask: Number of slots minus one.
+ * @vertex: The vertex to store.
+ */
+static void place_vertex(vertex_t **buckets, size_t mask, vertex_t *vertex)
+{
+	size_t i;
+
+	i = graph_hash_string(vertex->content) & mask;
+	while (buckets[i] != NULL)
+		i = (i + 1) & mask;
+	buckets[i] = vertex;
+}
+
+/**
+ * graph_index_reserve - Makes room in the graph's hash index for a given
+ * number of vertices, so that they can be inserted without rehashing.
+ * The index is kept at most half full so that probe chains stay short.
+ * @graph: Pointer to the graph.
+ * @nb_vertices: Total number of vertices the index must be able to hold.
+ * Return: 1 on success, 0 on failure.
+ */
+int graph_index_reserve(graph_t *graph, size_t nb_vertices)
+{
+	vertex_t **buckets;
+	size_t nb_buckets, i;
+
+	if (graph == NULL)
+		return (0);
+	if (nb_vertices * 2 <= graph->nb_buckets)
+		return (1);
+
+	nb_buckets = graph->nb_buckets ? graph->nb_buckets :
+		GRAPH_INDEX_MIN_BUCKETS;
+	while (nb_vertices * 2 > nb_buckets)
+		nb_buckets *= 2;
+	buckets = calloc(nb_buckets, sizeof(*buckets));
+	if (buckets == NULL)
+		return (0);
+
+	for (i = 0; i < graph->nb_buckets; i++)
+		if (graph->buckets[i] != NULL)
+			place_vertex(buckets, nb_buckets - 1, graph->buckets[i]);
+
+	free(graph->buckets);
+	graph->buckets = buckets;
+	graph->nb_buckets = nb_buckets;
+	return (1);
+}
+
+/**
+ * graph_index_insert - Registers a vertex in the graph's hash index.
+ * @graph: Pointer to the graph.
+ * @vertex: The vertex to register. Its content must not be indexed yet.
+ * Return: 1 on success, 0 on failure.
+ */
+int graph_index_insert(graph_t *graph, vertex_t *vertex)
+{
+	if (graph == NULL || vertex == NULL)
+		return (0);
+
+	if (!graph_index_reserve(graph, graph->nb_vertices + 1))
+		return (0);
+
+	place_vertex(graph->buckets, graph->nb_buckets - 1, vertex);
+	return (1);
+}
@@ -0,0 +1,236 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graphs.h"
+
+#define LOAD_CHUNK (1 << 16) /* Bytes read at once from a text file */
+#define LOAD_RECORDS 4096 /* Edges read at once from a binary file */
+/*
+ * Ids of a binary file beyond those its edges can reference, which become
+ * isolated vertices: the file backs every other id, so a short header
+ * cannot make the loader create billions of vertices
+ */
+#define LOAD_ISOLATED_MAX 65536
+#define LOAD_NODE(size) \
+	(((size) + GRAPH_ARENA_ALIGN - 1) & ~(GRAPH_ARENA_ALIGN - 1))
+/* Arena bytes of a vertex and its name (ids have at most 10 digits) */
+#define LOAD_VERTEX_BYTES (LOAD_NODE(sizeof(vertex_t)) + LOAD_NODE(12))
+/* Arena bytes of an edge */
+#define LOAD_EDGE_BYTES LOAD_NODE(sizeof(edge_t))
+/*
+ * Arena bytes of the edge sets per edge of a vertex past the threshold:
+ * a set holds 2 to 4 slots per edge, plus the smaller sets it outgrew
+ */
+#define LOAD_SET_BYTES (6 * sizeof(edge_t *))
+#define LE32(p) ((size_t)(p)[0] | (size_t)(p)[1] << 8 | \
+	(size_t)(p)[2] << 16 | (size_t)(p)[3] << 24)
+
+/**
+ * reserve_slab - Opens the first slab of a graph's arena with room for
+ * an estimated number of bytes, so that the loaded nodes land in a
+ * single block. The regular slab size is kept for any later slab, so an
+ * estimate that falls short only costs regular slabs.
+ * @graph: Pointer to the (empty) arena-backed graph being loaded.
+ * @bytes: Estimated number of bytes of the loaded nodes.
+ * Return: 1 on success, 0 on failure.
+ */
+static int reserve_slab(graph_t *graph, size_t bytes)
+{
+	size_t slab_size = graph->arena->slab_size;
+	void *slab;
+
+	if (bytes <= slab_size)
+		return (1);
+	graph->arena->slab_size = bytes;
+	slab = graph_alloc(graph, 0);
+	graph->arena->slab_size = slab_size;
+	return (slab != NULL);
+}
+
+/**
+ * parse_line - Adds the edge described by a "src dest" text line.
+ * Blank lines, comment lines ('#' or '%') and self-loops are skipped,
+ * and anything after the second field is ignored.
+ * @graph: Pointer to the graph being loaded.
+ * @line: The NUL-terminated line, split in place.
+ * @type: The type of the edge.
+ * Return: 1 on success, 0 on failure or malformed line.
+ */
+static int parse_line(graph_t *graph, char *line, edge_type_t type)
+{
+	char *src, *dest;
+	vertex_t *src_v, *dest_v;
+
+	src = line + strspn(line, " \t\r");
+	if (*src == '\0' || *src == '#' || *src == '%')
+		return (1);
+	dest = src + strcspn(src, " \t\r");
+	if (*dest == '\0')
+		return (0);
+	*dest++ = '\0';
+	dest += strspn(dest, " \t\r");
+	if (*dest == '\0')
+		return (0);
+	dest[strcspn(dest, " \t\r")] = '\0';
+
+	src_v = graph_find_vertex(graph, src);
+	if (src_v == NULL)
+		src_v = graph_insert_vertex(graph, src);
+	dest_v = graph_find_vertex(graph, dest);
+	if (dest_v == NULL)
+		dest_v = graph_insert_vertex(graph, dest);
+	if (src_v == NULL || dest_v == NULL)
+		return (0);
+	if (src_v == dest_v)
+		return (1);
+	return (graph_link_vertices(graph, src_v, dest_v, type));
+}
+
+/**
+ * load_text - Streams a text edge list, one "src dest" pair per line.
+ * The file is read in LOAD_CHUNK blocks; a line split across two blocks
+ * is moved to the front of the buffer before the next read.
+ * @graph: Pointer to the graph being loaded.
+ * @file: The file, positioned at its beginning.
+ * @type: The type of the edges.
+ * Return: 1 on success, 0 on failure.
+ */
+static int load_text(graph_t *graph, FILE *file, edge_type_t type)
+{
+	char *buf, *line, *eol, *tmp;
+	size_t cap = LOAD_CHUNK, len = 0, got;
+	int ok = 1;
+
+	buf = malloc(cap + 1);
+	if (buf == NULL)
+		return (0);
+	do {
+		got = fread(buf + len, 1, cap - len, file);
+		len += got;
+		if (got == 0 && len > 0 && buf[len - 1] != '\n')
+			buf[len++] = '\n'; /* Last line has no newline */
+		line = buf;
+		while (ok && (eol = memchr(line, '\n', buf + len - line)) != NULL)
+		{
+			*eol = '\0';
+			ok = parse_line(graph, line, type);
+			line = eol + 1;
+		}
+		len -= line - buf;
+		memmove(buf, line, len);
+		if (ok && len == cap)
+		{
+			tmp = realloc(buf, cap * 2 + 1);
+			ok = tmp != NULL;
+			buf = tmp ? tmp : buf;
+			cap *= 2;
+		}
+	} while (ok && got > 0);
+	free(buf);
+	return (ok && !ferror(file));
+}
+
+/**
+ * load_binary - Reads a binary edge list (see GRAPH_EDGELIST_MAGIC).
+ * Every vertex is created up front, named after its id, and edges are
+ * then resolved through an id-indexed table instead of by name. Files
+ * with more than LOAD_ISOLATED_MAX ids beyond twice their edges are
+ * refused.
+ * @graph: Pointer to the (empty) graph being loaded.
+ * @file: The file, positioned right after the magic.
+ * @size: Size of the file in bytes.
+ * @type: The type of the edges.
+ * Return: 1 on success, 0 on failure.
+ */
+static int load_binary(graph_t *graph, FILE *file, size_t size,
+					   edge_type_t type)
+{
+	unsigned char head[12], rec[LOAD_RECORDS * 8], *p;
+	size_t nb_v, nb_e, nb_arcs, i, n, src, dest;
+	vertex_t **ids;
+	char name[24];
+	int ok;
+
+	if (fread(head, 1, sizeof(head), file) != sizeof(head))
+		return (0);
+	nb_v = LE32(head);
+	nb_e = LE32(head + 4) | LE32(head + 8) << 16 << 16; /* 32-bit safe */
+	if (size < 16 || nb_e != (size - 16) / 8 || (size - 16) % 8 ||
+		nb_v > 2 * nb_e + LOAD_ISOLATED_MAX)
+		return (0);
+	/* Ids no edge uses are not backed by the file: do not size on them */
+	n = nb_v < 2 * nb_e ? nb_v : 2 * nb_e;
+	nb_arcs = nb_e * (type == BIDIRECTIONAL ? 2 : 1);
+	ids = malloc(sizeof(*ids) * (nb_v ? nb_v : 1));
+	ok = ids != NULL && graph_index_reserve(graph, nb_v) &&
+		reserve_slab(graph, n * LOAD_VERTEX_BYTES + nb_arcs *
+					 (nb_arcs < n * GRAPH_EDGE_SET_THRESHOLD ? LOAD_EDGE_BYTES :
+					  LOAD_EDGE_BYTES + LOAD_SET_BYTES));
+	for (i = 0; ok && i < nb_v; i++)
+	{
+		sprintf(name, "%lu", (unsigned long)i);
+		ids[i] = graph_insert_vertex(graph, name);
+		ok = ids[i] != NULL;
+	}
+	for (i = 0; ok && i < nb_e; i += n)
+	{
+		n = nb_e - i < LOAD_RECORDS ? nb_e - i : LOAD_RECORDS;
+		ok = fread(rec, 8, n, file) == n;
+		for (p = rec; ok && p < rec + n * 8; p += 8)
+		{
+			src = LE32(p), dest = LE32(p + 4);
+			ok = src < nb_v && dest < nb_v;
+			if (ok && src != dest)
+				ok = graph_link_vertices(graph, ids[src], ids[dest], type);
+		}
+	}
+	free(ids);
+	return (ok);
+}
+
+/**
+ * graph_load_edgelist - Builds a graph from an edge-list file in one pass.
+ * The file is either text, one "src dest" pair of vertex names per line,
+ * or binary (see GRAPH_EDGELIST_MAGIC), in which case vertices are named
+ * after their id. The graph is arena-backed, its first slab sized from
+ * the file size so that the nodes land in a single large block.
+ * @path: Path to the file.
+ * @type: The type of every edge of the file.
+ * Return: A pointer to the loaded graph, or NULL on failure.
+ */
+graph_t *graph_load_edgelist(const char *path, edge_type_t type)
+{
+	FILE *file;
+	graph_t *graph;
+	char magic[4];
+	long size;
+	int ok;
+
+	if (path == NULL)
+		return (NULL);
+	file = fopen(path, "rb");
+	if (file == NULL)
+		return (NULL);
+	size = fseek(file, 0, SEEK_END) == 0 ? ftell(file) : 0;
+	graph = graph_create_arena(0);
+	ok = graph != NULL && fseek(file, 0, SEEK_SET) == 0;
+	if (ok && fread(magic, 1, 4, file) == 4 &&
+		memcmp(magic, GRAPH_EDGELIST_MAGIC, 4) == 0)
+		ok = size > 0 && load_binary(graph, file, (size_t)size, type);
+	else if (ok)
+	{
+		/* Assume lines of 12 bytes, every other one naming a new vertex */
+		if (size > 0)
+			ok = reserve_slab(graph, (size_t)size / 12 * (LOAD_VERTEX_BYTES / 2 +
+				(type == BIDIRECTIONAL ? 2 : 1) * LOAD_EDGE_BYTES));
+		ok = ok && fseek(file, 0, SEEK_SET) == 0 &&
+			load_text(graph, file, type);
+	}
+	fclose(file);
+	if (!ok)
+	{
+		graph_delete(graph);
+		return (NULL);
+	}
+	return (graph);
+}
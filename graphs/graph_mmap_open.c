@@ -0,0 +1,134 @@
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "graphs.h"
+
+#define SHIFT(p, delta) ((p) ? (void *)((uintptr_t)(p) + (delta)) : NULL)
+
+/**
+ * region_fits - Checks that an array of the image starts at an aligned
+ * offset and ends before another offset, without overflowing.
+ * @offset: Offset of the array.
+ * @count: Number of elements of the array.
+ * @elem_size: Size of an element.
+ * @end: Offset the array must end at or before.
+ * Return: 1 if it fits, 0 otherwise.
+ */
+static int region_fits(uint64_t offset, uint64_t count, size_t elem_size,
+					   uint64_t end)
+{
+	return (offset % sizeof(void *) == 0 && offset <= end &&
+			count <= (end - offset) / elem_size);
+}
+
+/**
+ * image_valid - Checks that an image header matches this host and file,
+ * and that its arrays lie in order within the file, so that relocating
+ * them never writes out of the mapping.
+ * @img: Header read from the file.
+ * @file_size: Size of the file in bytes.
+ * Return: 1 if the image can be mapped, 0 otherwise.
+ */
+static int image_valid(const graph_image_t *img, size_t file_size)
+{
+	return (memcmp(img->magic, GRAPH_IMAGE_MAGIC, sizeof(img->magic)) == 0 &&
+			img->version == GRAPH_IMAGE_VERSION &&
+			img->byte_order == 0x01020304 &&
+			img->word_size == sizeof(void *) &&
+			img->size == file_size &&
+			img->graph >= sizeof(*img) &&
+			region_fits(img->graph, 1, sizeof(graph_t), img->vertices) &&
+			region_fits(img->vertices, img->nb_slots, sizeof(vertex_t),
+						img->edges) &&
+			region_fits(img->edges, img->nb_edges, sizeof(edge_t),
+						img->buckets) &&
+			region_fits(img->buckets, 0, 1, img->strings) &&
+			img->strings <= img->size);
+}
+
+/**
+ * relocate - Rebases every pointer of an image mapped somewhere else than
+ * the address it was encoded for.
+ * @map: Address the image is mapped at.
+ * @delta: Difference between that address and the encoded one.
+ */
+static void relocate(char *map, uintptr_t delta)
+{
+	graph_image_t *img = (graph_image_t *)map;
+	graph_t *graph = (graph_t *)(map + img->graph);
+	vertex_t *v = (vertex_t *)(map + img->vertices);
+	edge_t *e = (edge_t *)(map + img->edges);
+	vertex_t **slot = (vertex_t **)(map + img->buckets);
+	uint64_t i;
+
+	graph->vertices = SHIFT(graph->vertices, delta);
+	graph->vertices_tail = SHIFT(graph->vertices_tail, delta);
+	graph->buckets = SHIFT(graph->buckets, delta);
+	for (i = 0; i < img->nb_slots; i++)
+	{
+		v[i].content = SHIFT(v[i].content, delta);
+		v[i].edges = SHIFT(v[i].edges, delta);
+		v[i].edges_tail = SHIFT(v[i].edges_tail, delta);
+		v[i].next = SHIFT(v[i].next, delta);
+		v[i].prev = SHIFT(v[i].prev, delta);
+	}
+	for (i = 0; i < img->nb_edges; i++)
+	{
+		e[i].dest = SHIFT(e[i].dest, delta);
+		e[i].next = SHIFT(e[i].next, delta);
+	}
+	for (i = 0; i < graph->nb_buckets; i++)
+		slot[i] = SHIFT(slot[i], delta);
+}
+
+/**
+ * graph_mmap_open - Maps a graph image written by graph_save.
+ * The image is mapped privately at the address it was encoded for when
+ * possible, in which case nothing is touched but the graph_t; otherwise its
+ * pointers are rebased in place. Either way, images whose contents are not
+ * consistent are refused (see graph_image_check). The resulting graph can
+ * be traversed and searched like any other, but not modified.
+ * graph_delete unmaps it.
+ * @path: Path to the image file.
+ * Return: A pointer to the mapped graph, or NULL on failure.
+ */
+graph_t *graph_mmap_open(const char *path)
+{
+	graph_image_t img;
+	struct stat st;
+	graph_t *graph;
+	char *map;
+	int fd;
+
+	if (path == NULL)
+		return (NULL);
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (NULL);
+	if (fstat(fd, &st) != 0 || read(fd, &img, sizeof(img)) != sizeof(img) ||
+		!image_valid(&img, (size_t)st.st_size))
+	{
+		close(fd);
+		return (NULL);
+	}
+	map = mmap((void *)(uintptr_t)img.base, img.size, PROT_READ | PROT_WRITE,
+			   MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return (NULL);
+
+	graph = (graph_t *)(map + img.graph);
+	if (!region_fits(img.buckets, graph->nb_buckets, sizeof(vertex_t *),
+					 img.strings) || !graph_image_check(&img, map))
+	{
+		munmap(map, img.size);
+		return (NULL);
+	}
+	if ((uintptr_t)map != img.base)
+		relocate(map, (uintptr_t)map - (uintptr_t)img.base);
+	graph->mapping = map;
+	graph->mapping_size = img.size;
+	return (graph);
+}
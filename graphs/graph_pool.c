@@ -0,0 +1,154 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "graphs.h"
+
+/**
+ * struct graph_pool_s - Pool of worker threads running the same task
+ * together, one round at a time
+ *
+ * @lock: Protects every other field
+ * @start: Signaled when a new round starts or the pool stops
+ * @done: Signaled when the last worker finishes the round
+ * @threads: The workers (@nb_threads - 1, the caller being thread 0)
+ * @nb_threads: Number of threads taking part in a round
+ * @nb_started: Number of workers that picked their id
+ * @task: Task of the current round
+ * @arg: Argument of the current round's task
+ * @round: Number of rounds started so far
+ * @running: Number of workers still busy with the current round
+ * @stop: Set when the pool is being deleted
+ */
+struct graph_pool_s
+{
+	pthread_mutex_t lock;
+	pthread_cond_t start;
+	pthread_cond_t done;
+	pthread_t *threads;
+	size_t nb_threads;
+	size_t nb_started;
+	void (*task)(void *arg, size_t thread_id);
+	void *arg;
+	size_t round;
+	size_t running;
+	int stop;
+};
+
+/**
+ * pool_worker - Body of a worker thread: waits for rounds and runs them.
+ * @data: Pointer to the pool.
+ * Return: NULL.
+ */
+static void *pool_worker(void *data)
+{
+	graph_pool_t *pool = data;
+	size_t id, seen = 0;
+
+	pthread_mutex_lock(&pool->lock);
+	id = ++pool->nb_started;
+	while (1)
+	{
+		while (pool->round == seen && !pool->stop)
+			pthread_cond_wait(&pool->start, &pool->lock);
+		if (pool->stop)
+			break;
+		seen = pool->round;
+		pthread_mutex_unlock(&pool->lock);
+		pool->task(pool->arg, id);
+		pthread_mutex_lock(&pool->lock);
+		if (--pool->running == 0)
+			pthread_cond_signal(&pool->done);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return (NULL);
+}
+
+/**
+ * graph_pool_create - Starts a pool of worker threads.
+ * @nb_threads: Number of threads taking part in each round, the calling
+ * thread included, or 0 for one per online processor. Updated with the
+ * number of threads actually started, which may be lower.
+ * Return: A pointer to the pool, or NULL on failure.
+ */
+graph_pool_t *graph_pool_create(size_t *nb_threads)
+{
+	graph_pool_t *pool;
+	long nb_cpus;
+
+	if (*nb_threads == 0)
+	{
+		nb_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		*nb_threads = nb_cpus > 0 ? (size_t)nb_cpus : 1;
+	}
+	pool = calloc(1, sizeof(*pool));
+	if (pool == NULL)
+		return (NULL);
+	pool->threads = malloc(sizeof(*pool->threads) * *nb_threads);
+	if (pool->threads == NULL)
+	{
+		free(pool);
+		return (NULL);
+	}
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->start, NULL);
+	pthread_cond_init(&pool->done, NULL);
+	for (pool->nb_threads = 1; pool->nb_threads < *nb_threads;
+		 pool->nb_threads++)
+		if (pthread_create(&pool->threads[pool->nb_threads - 1], NULL,
+						   pool_worker, pool) != 0)
+			break; /* Run with the threads we could get */
+	*nb_threads = pool->nb_threads;
+	return (pool);
+}
+
+/**
+ * graph_pool_run - Runs a task on every thread of the pool, the calling
+ * thread being thread 0, and waits until all of them are done.
+ * @pool: Pointer to the pool.
+ * @task: Function run by each thread, with @arg and the thread id, from
+ * 0 to the number of threads of the pool minus one.
+ * @arg: Argument passed to the task.
+ */
+void graph_pool_run(graph_pool_t *pool,
+					void (*task)(void *arg, size_t thread_id), void *arg)
+{
+	pthread_mutex_lock(&pool->lock);
+	pool->task = task;
+	pool->arg = arg;
+	pool->running = pool->nb_threads - 1;
+	pool->round++;
+	pthread_cond_broadcast(&pool->start);
+	pthread_mutex_unlock(&pool->lock);
+
+	task(arg, 0);
+
+	pthread_mutex_lock(&pool->lock);
+	while (pool->running > 0)
+		pthread_cond_wait(&pool->done, &pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * graph_pool_delete - Stops the workers of a pool and deletes it.
+ * @pool: Pointer to the pool.
+ */
+void graph_pool_delete(graph_pool_t *pool)
+{
+	size_t i;
+
+	if (pool == NULL)
+		return;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->stop = 1;
+	pthread_cond_broadcast(&pool->start);
+	pthread_mutex_unlock(&pool->lock);
+	for (i = 0; i + 1 < pool->nb_threads; i++)
+		pthread_join(pool->threads[i], NULL);
+
+	pthread_mutex_destroy(&pool->lock);
+	pthread_cond_destroy(&pool->start);
+	pthread_cond_destroy(&pool->done);
+	free(pool->threads);
+	free(pool);
+}
@@ -0,0 +1,114 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/**
+ * edge_set_remove - Removes an edge from its source's edge set, shifting
+ * back the entries of its probe chain so that no tombstone is needed.
+ * @src: The source vertex of the edge.
+ * @edge: The edge to remove.
+ */
+static void edge_set_remove(vertex_t *src, const edge_t *edge)
+{
+	size_t mask = src->edge_set_size - 1, hole, i, home;
+
+	hole = graph_edge_slot(edge->dest, mask);
+	while (src->edge_set[hole] != edge)
+		hole = (hole + 1) & mask;
+
+	for (i = (hole + 1) & mask; src->edge_set[i] != NULL; i = (i + 1) & mask)
+	{
+		home = graph_edge_slot(src->edge_set[i]->dest, mask);
+		/* Move the entry only if the hole lies on its probe path */
+		if (((i - home) & mask) >= ((i - hole) & mask))
+		{
+			src->edge_set[hole] = src->edge_set[i];
+			hole = i;
+		}
+	}
+	src->edge_set[hole] = NULL;
+}
+
+/**
+ * unlink_edge - Removes the edge going from a vertex to another.
+ * Takes time proportional to the degree of @src.
+ * @graph: Pointer to the graph the vertices belong to.
+ * @src: The source vertex.
+ * @dest: The destination vertex.
+ * Return: 1 if the edge existed and was removed, 0 otherwise.
+ */
+static int unlink_edge(graph_t *graph, vertex_t *src, vertex_t *dest)
+{
+	edge_t *edge, *prev = NULL;
+
+	for (edge = src->edges; edge != NULL; prev = edge, edge = edge->next)
+		if (edge->dest == dest)
+			break;
+	if (edge == NULL)
+		return (0);
+
+	if (prev == NULL)
+		src->edges = edge->next;
+	else
+		prev->next = edge->next;
+	if (src->edges_tail == edge)
+		src->edges_tail = prev;
+	if (src->edge_set != NULL)
+		edge_set_remove(src, edge);
+	src->nb_edges--;
+	graph_in_edge_remove(graph, dest, src);
+	graph_free(graph, edge);
+	return (1);
+}
+
+/**
+ * graph_unlink_vertices - Removes the edge between two vertices already
+ * resolved to their vertex_t, without looking them up by content.
+ * @graph: Pointer to the graph the vertices belong to.
+ * @src_v: The vertex the connection is made from.
+ * @dest_v: The vertex it connects to.
+ * @type: UNIDIRECTIONAL to only remove the edge from @src_v to @dest_v,
+ * BIDIRECTIONAL to also remove the edge from @dest_v to @src_v, if any.
+ * Return: 1 if the edge from @src_v to @dest_v was removed, or 0 if there
+ * was none. Mapped graphs are read-only and always fail.
+ */
+int graph_unlink_vertices(graph_t *graph, vertex_t *src_v,
+						  vertex_t *dest_v, edge_type_t type)
+{
+	int removed;
+
+	if (graph == NULL || src_v == NULL || dest_v == NULL ||
+		graph->mapping != NULL)
+		return (0);
+
+	removed = unlink_edge(graph, src_v, dest_v);
+	if (type == BIDIRECTIONAL)
+		unlink_edge(graph, dest_v, src_v);
+	return (removed);
+}
+
+/**
+ * graph_remove_edge - Removes an edge between two vertices of a graph.
+ * Takes time proportional to the degree of the vertices involved.
+ * The memory of the edge goes back to the arena only when the graph is
+ * deleted, for arena-backed graphs.
+ * @graph: Pointer to the graph to remove the edge from.
+ * @src: The string identifying the vertex the connection is made from.
+ * @dest: The string identifying the vertex it connects to.
+ * @type: The type of edge (UNIDIRECTIONAL or BIDIRECTIONAL).
+ * Return: 1 if the edge from @src to @dest was removed, or 0 on failure.
+ */
+int graph_remove_edge(graph_t *graph, const char *src,
+					  const char *dest, edge_type_t type)
+{
+	vertex_t *src_v, *dest_v;
+
+	if (graph == NULL || src == NULL || dest == NULL)
+		return (0);
+
+	src_v = graph_find_vertex(graph, src);
+	dest_v = graph_find_vertex(graph, dest);
+	if (src_v == NULL || dest_v == NULL)
+		return (0); /* Source or destination vertex not found */
+
+	return (graph_unlink_vertices(graph, src_v, dest_v, type));
+}
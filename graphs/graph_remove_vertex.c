@@ -0,0 +1,91 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/**
+ * index_remove - Unregisters a vertex from the graph's hash index,
+ * shifting back the entries of its probe chain so that no tombstone is
+ * needed.
+ * @graph: Pointer to the graph.
+ * @vertex: The vertex to unregister.
+ */
+static void index_remove(graph_t *graph, const vertex_t *vertex)
+{
+	size_t mask = graph->nb_buckets - 1, hole, i, home;
+
+	hole = graph_hash_string(vertex->content) & mask;
+	while (graph->buckets[hole] != vertex)
+		hole = (hole + 1) & mask;
+
+	for (i = (hole + 1) & mask; graph->buckets[i] != NULL; i = (i + 1) & mask)
+	{
+		home = graph_hash_string(graph->buckets[i]->content) & mask;
+		/* Move the entry only if the hole lies on its probe path */
+		if (((i - home) & mask) >= ((i - hole) & mask))
+		{
+			graph->buckets[hole] = graph->buckets[i];
+			hole = i;
+		}
+	}
+	graph->buckets[hole] = NULL;
+}
+
+/**
+ * unlink_vertex - Takes a vertex out of the adjacency linked list.
+ * @graph: Pointer to the graph.
+ * @vertex: The vertex to take out.
+ */
+static void unlink_vertex(graph_t *graph, vertex_t *vertex)
+{
+	if (vertex->prev == NULL)
+		graph->vertices = vertex->next;
+	else
+		vertex->prev->next = vertex->next;
+	if (vertex->next == NULL)
+		graph->vertices_tail = vertex->prev;
+	else
+		vertex->next->prev = vertex->prev;
+}
+
+/**
+ * graph_remove_vertex - Removes a vertex and every edge leading to or
+ * from it. Takes time proportional to the degree of the vertex and of its
+ * neighbors, except for the first removal from a graph, which builds the
+ * incoming edge lists (see graph_track_in_edges).
+ * The vertex's index is handed to the next vertex added, so that indices
+ * stay below graph_s::nb_slots; the indices of the other vertices are
+ * left untouched.
+ * @graph: Pointer to the graph to remove the vertex from.
+ * @str: The string identifying the vertex.
+ * Return: 1 on success, or 0 on failure.
+ * Mapped graphs are read-only and always fail.
+ */
+int graph_remove_vertex(graph_t *graph, const char *str)
+{
+	vertex_t *vertex;
+
+	if (graph == NULL || str == NULL || graph->mapping != NULL)
+		return (0);
+
+	vertex = graph_find_vertex(graph, str);
+	if (vertex == NULL || !graph_track_in_edges(graph))
+		return (0);
+
+	while (vertex->edges != NULL)
+		graph_unlink_vertices(graph, vertex, vertex->edges->dest,
+							  UNIDIRECTIONAL);
+	while (vertex->in_edges != NULL)
+		graph_unlink_vertices(graph, vertex->in_edges->dest, vertex,
+							  UNIDIRECTIONAL);
+
+	index_remove(graph, vertex);
+	unlink_vertex(graph, vertex);
+	graph->nb_vertices--;
+
+	graph_free(graph, vertex->edge_set);
+	graph_free(graph, vertex->content);
+	vertex->edge_set = NULL;
+	vertex->content = NULL;
+	vertex->next = graph->free_vertices;
+	graph->free_vertices = vertex;
+	return (1);
+}
@@ -0,0 +1,117 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/**
+ * by_degree - Compares two vertices by degree, then by index, for qsort.
+ * @a: Pointer to the first vertex pointer.
+ * @b: Pointer to the second vertex pointer.
+ * Return: A negative, zero or positive value as @a sorts before, with or
+ * after @b.
+ */
+static int by_degree(const void *a, const void *b)
+{
+	const vertex_t *va = *(vertex_t *const *)a, *vb = *(vertex_t *const *)b;
+
+	if (va->nb_edges != vb->nb_edges)
+		return (va->nb_edges < vb->nb_edges ? -1 : 1);
+	return (va->index < vb->index ? -1 : va->index > vb->index);
+}
+
+/**
+ * cm_component - Appends the vertices reachable from a vertex to an order,
+ * breadth-first. With Cuthill-McKee, the vertices discovered from a vertex
+ * are sorted by increasing degree.
+ * @order: The order being built.
+ * @tail: Number of vertices already in @order.
+ * @start: The vertex to start from, not seen yet.
+ * @seen: Per (current) vertex index, whether the vertex is in @order.
+ * @cm: 1 for Cuthill-McKee, 0 for a plain breadth-first order.
+ * Return: The new number of vertices in @order.
+ */
+static size_t cm_component(vertex_t **order, size_t tail, vertex_t *start,
+						   unsigned char *seen, int cm)
+{
+	size_t head = tail, first;
+	const edge_t *edge;
+
+	seen[start->index] = 1;
+	order[tail++] = start;
+	for (; head < tail; head++)
+	{
+		first = tail;
+		for (edge = order[head]->edges; edge != NULL; edge = edge->next)
+			if (!seen[edge->dest->index])
+			{
+				seen[edge->dest->index] = 1;
+				order[tail++] = edge->dest;
+			}
+		if (cm && tail - first > 1)
+			qsort(order + first, tail - first, sizeof(*order), by_degree);
+	}
+	return (tail);
+}
+
+/**
+ * renumber_vertices - Gives the vertices their indices in a new order.
+ * Removed vertices awaiting reuse take the indices after the live ones,
+ * so that the indices in use are dense again.
+ * @graph: Pointer to the graph.
+ * @order: The live vertices, in their new order.
+ * @reverse: 1 to number @order backwards.
+ */
+static void renumber_vertices(graph_t *graph, vertex_t **order, int reverse)
+{
+	vertex_t *v;
+	size_t i, n = graph->nb_vertices;
+
+	for (i = 0; i < n; i++)
+		order[reverse ? n - 1 - i : i]->index = i;
+	for (v = graph->free_vertices; v != NULL; v = v->next)
+		v->index = i++;
+	graph->nb_slots = i;
+}
+
+/**
+ * graph_reorder - Renumbers the vertices of a graph so that neighbours
+ * get close indices: traversals then touch the per-index arrays (visited
+ * sets, distances, ...) in a mostly sequential way, and freezing the
+ * graph afterwards gives a snapshot laid out in the new order. Only the
+ * indices change: the vertex list and the edge lists keep their order,
+ * so traversals visit the same vertices in the same order and at the
+ * same depths as before, and names and vertex pointers stay valid.
+ * Neighbours are the destinations of each vertex's edges, so the graph
+ * is best made of BIDIRECTIONAL edges.
+ * @graph: Pointer to the graph to reorder (not mapped from an image).
+ * @order: GRAPH_ORDER_BFS or GRAPH_ORDER_RCM.
+ * Return: 1 on success, 0 on failure (the graph is left unchanged).
+ */
+int graph_reorder(graph_t *graph, graph_order_t order)
+{
+	vertex_t **vertices, *v;
+	unsigned char *seen;
+	size_t n = 0, i;
+
+	if (graph == NULL || graph->mapping != NULL ||
+		(order != GRAPH_ORDER_BFS && order != GRAPH_ORDER_RCM))
+		return (0);
+	if (graph->nb_vertices == 0)
+		return (1);
+	vertices = malloc(sizeof(*vertices) * 2 * graph->nb_vertices);
+	seen = calloc(graph->nb_slots, sizeof(*seen));
+	if (vertices != NULL && seen != NULL)
+	{
+		/* The starts of the components follow the order itself */
+		for (i = 0, v = graph->vertices; v != NULL; v = v->next)
+			vertices[graph->nb_vertices + i++] = v;
+		if (order == GRAPH_ORDER_RCM)
+			qsort(vertices + graph->nb_vertices, graph->nb_vertices,
+				  sizeof(*vertices), by_degree);
+		for (i = graph->nb_vertices; i < 2 * graph->nb_vertices; i++)
+			if (!seen[vertices[i]->index])
+				n = cm_component(vertices, n, vertices[i], seen,
+								 order == GRAPH_ORDER_RCM);
+		renumber_vertices(graph, vertices, order == GRAPH_ORDER_RCM);
+	}
+	free(seen), free(vertices);
+	return (n == graph->nb_vertices);
+}
@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graphs.h"
+
+#define ALIGN16(n) (((n) + 15) & ~(uint64_t)15)
+#define AT(img, off) ((void *)(uintptr_t)((img)->base + (off)))
+#define VERTEX_AT(img, v) ((v) ? AT(img, (img)->vertices + \
+	(v)->index * sizeof(vertex_t)) : NULL)
+
+/**
+ * plan_image - Computes the layout of the image of a graph.
+ * @graph: Pointer to the graph.
+ * @img: Header to fill in.
+ * Return: The vertices of the graph by index, or NULL on failure.
+ */
+static vertex_t **plan_image(const graph_t *graph, graph_image_t *img)
+{
+	vertex_t **by_index, *v;
+	uint64_t nb_strings = 0;
+
+	by_index = calloc(graph->nb_slots + 1, sizeof(*by_index));
+	if (by_index == NULL)
+		return (NULL);
+
+	memset(img, 0, sizeof(*img));
+	for (v = graph->vertices; v != NULL; v = v->next)
+	{
+		by_index[v->index] = v;
+		img->nb_edges += v->nb_edges;
+		nb_strings += strlen(v->content) + 1;
+	}
+	memcpy(img->magic, GRAPH_IMAGE_MAGIC, sizeof(img->magic));
+	img->version = GRAPH_IMAGE_VERSION;
+	img->byte_order = 0x01020304;
+	img->word_size = sizeof(void *);
+	img->base = GRAPH_IMAGE_BASE;
+	img->nb_slots = graph->nb_slots;
+	img->graph = ALIGN16(sizeof(*img));
+	img->vertices = ALIGN16(img->graph + sizeof(graph_t));
+	img->edges = ALIGN16(img->vertices + img->nb_slots * sizeof(vertex_t));
+	img->buckets = ALIGN16(img->edges + img->nb_edges * sizeof(edge_t));
+	img->strings = img->buckets + graph->nb_buckets * sizeof(vertex_t *);
+	img->size = img->strings + nb_strings;
+	return (by_index);
+}
+
+/**
+ * pad - Writes zeros to move from one offset of the image to another.
+ * @file: The image file.
+ * @from: Current offset.
+ * @to: Offset to reach (at most 15 bytes further).
+ * Return: 1 on success, 0 on failure.
+ */
+static int pad(FILE *file, uint64_t from, uint64_t to)
+{
+	static const char zeros[16];
+
+	return (fwrite(zeros, 1, (size_t)(to - from), file) == to - from);
+}
+
+/**
+ * write_vertices - Writes the vertex slots of the image, in index order.
+ * The edges and strings of each vertex are laid out in the same order.
+ * @img: Header of the image.
+ * @by_index: The vertices of the graph by index.
+ * @file: The image file.
+ * Return: 1 on success, 0 on failure.
+ */
+static int write_vertices(const graph_image_t *img, vertex_t **by_index,
+						  FILE *file)
+{
+	vertex_t rec;
+	uint64_t i, edge = img->edges, string = img->strings;
+
+	for (i = 0; i < img->nb_slots; i++)
+	{
+		memset(&rec, 0, sizeof(rec));
+		if (by_index[i] != NULL)
+		{
+			rec.index = i;
+			rec.content = AT(img, string);
+			rec.nb_edges = by_index[i]->nb_edges;
+			rec.edges = rec.nb_edges ? AT(img, edge) : NULL;
+			edge += rec.nb_edges * sizeof(edge_t);
+			rec.edges_tail = rec.nb_edges ?
+				AT(img, edge - sizeof(edge_t)) : NULL;
+			rec.next = VERTEX_AT(img, by_index[i]->next);
+			rec.prev = VERTEX_AT(img, by_index[i]->prev);
+			string += strlen(by_index[i]->content) + 1;
+		}
+		if (fwrite(&rec, sizeof(rec), 1, file) != 1)
+			return (0);
+	}
+	return (1);
+}
+
+/**
+ * write_edges - Writes the edges, the hash index and the strings of the
+ * image, each vertex's edges being stored contiguously in index order.
+ * @graph: Pointer to the graph.
+ * @img: Header of the image.
+ * @by_index: The vertices of the graph by index.
+ * @file: The image file.
+ * Return: 1 on success, 0 on failure.
+ */
+static int write_edges(const graph_t *graph, const graph_image_t *img,
+					   vertex_t **by_index, FILE *file)
+{
+	edge_t rec, *e;
+	uint64_t i, pos = img->edges;
+	vertex_t *slot;
+	int ok = 1;
+
+	for (i = 0; ok && i < img->nb_slots; i++)
+		for (e = by_index[i] ? by_index[i]->edges : NULL; ok && e; e = e->next)
+		{
+			rec = *e;
+			rec.dest = VERTEX_AT(img, e->dest);
+			pos += sizeof(rec);
+			rec.next = e->next ? AT(img, pos) : NULL;
+			ok = fwrite(&rec, sizeof(rec), 1, file) == 1;
+		}
+	ok = ok && pad(file, pos, img->buckets);
+	for (i = 0; ok && i < graph->nb_buckets; i++)
+	{
+		slot = VERTEX_AT(img, graph->buckets[i]);
+		ok = fwrite(&slot, sizeof(slot), 1, file) == 1;
+	}
+	for (i = 0; ok && i < img->nb_slots; i++)
+		if (by_index[i] != NULL)
+			ok = fputs(by_index[i]->content, file) != EOF &&
+				fputc('\0', file) != EOF;
+	return (ok);
+}
+
+/**
+ * graph_save - Writes a graph as an image that graph_mmap_open can map
+ * back without parsing or allocating anything per vertex or edge.
+ * Images are meant to be read on the same architecture they were saved on.
+ * @graph: Pointer to the graph to save.
+ * @path: Path to the image file to create.
+ * Return: 1 on success, or 0 on failure.
+ */
+int graph_save(const graph_t *graph, const char *path)
+{
+	graph_image_t img;
+	graph_t rec;
+	vertex_t **by_index;
+	FILE *file;
+	int ok;
+
+	if (graph == NULL || path == NULL)
+		return (0);
+	by_index = plan_image(graph, &img);
+	if (by_index == NULL)
+		return (0);
+
+	memset(&rec, 0, sizeof(rec));
+	rec.nb_vertices = graph->nb_vertices;
+	rec.nb_slots = graph->nb_slots;
+	rec.nb_duplicate_edges = graph->nb_duplicate_edges;
+	rec.vertices = VERTEX_AT(&img, graph->vertices);
+	rec.vertices_tail = VERTEX_AT(&img, graph->vertices_tail);
+	rec.buckets = graph->nb_buckets ? AT(&img, img.buckets) : NULL;
+	rec.nb_buckets = graph->nb_buckets;
+	file = fopen(path, "wb");
+	ok = file != NULL && fwrite(&img, sizeof(img), 1, file) == 1 &&
+		pad(file, sizeof(img), img.graph) &&
+		fwrite(&rec, sizeof(rec), 1, file) == 1 &&
+		pad(file, img.graph + sizeof(rec), img.vertices) &&
+		write_vertices(&img, by_index, file) &&
+		pad(file, img.vertices + img.nb_slots * sizeof(vertex_t), img.edges) &&
+		write_edges(graph, &img, by_index, file);
+	if (file != NULL && fclose(file) != 0)
+		ok = 0;
+	if (!ok && file != NULL)
+		remove(path);
+	free(by_index);
+	return (ok);
+}
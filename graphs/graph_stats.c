@@ -0,0 +1,85 @@
+#include <stdlib.h>
+#include <string.h>
+#include "graphs.h"
+
+/**
+ * degree_bucket - Finds the bucket of the degree histogram of graph_stats
+ * a degree falls in.
+ * @degree: The degree.
+ * Return: 0 for a degree of 0, k for a degree in [2^(k-1), 2^k).
+ */
+static size_t degree_bucket(size_t degree)
+{
+	size_t bucket = 0;
+
+	for (; degree != 0; degree >>= 1)
+		bucket++;
+	return (bucket);
+}
+
+/**
+ * held_bytes - Computes the memory held by a graph as a whole.
+ * @graph: Pointer to the graph.
+ * @stats: The figures gathered so far, whose @total_bytes is filled.
+ */
+static void held_bytes(const graph_t *graph, graph_stats_t *stats)
+{
+	const graph_slab_t *slab;
+
+	if (graph->mapping != NULL)
+	{
+		stats->total_bytes = graph->mapping_size;
+		return;
+	}
+	stats->total_bytes = sizeof(*graph) + stats->index_bytes;
+	if (graph->arena == NULL)
+	{
+		stats->total_bytes += stats->vertex_bytes + stats->edge_bytes +
+			stats->in_edge_bytes + stats->string_bytes +
+			stats->edge_set_bytes;
+		return;
+	}
+	stats->total_bytes += sizeof(*graph->arena);
+	for (slab = graph->arena->slabs; slab != NULL; slab = slab->next)
+		stats->total_bytes += GRAPH_SLAB_HEADER + slab->size;
+}
+
+/**
+ * graph_stats - Gathers figures about a graph: sizes, degree distribution,
+ * duplicate edges, and the memory taken by each kind of node. Every vertex
+ * is read once, in list order, along with its content string; the edge
+ * lists are not walked, the vertices knowing their degree.
+ * @graph: Pointer to the graph.
+ * @stats: Pointer to the figures to fill.
+ * Return: 1 on success, 0 on failure.
+ */
+int graph_stats(const graph_t *graph, graph_stats_t *stats)
+{
+	const vertex_t *v;
+
+	if (graph == NULL || stats == NULL)
+		return (0);
+
+	memset(stats, 0, sizeof(*stats));
+	for (v = graph->vertices; v != NULL; v = v->next)
+	{
+		stats->nb_edges += v->nb_edges;
+		if (v->nb_edges > stats->max_degree)
+			stats->max_degree = v->nb_edges;
+		stats->degrees[degree_bucket(v->nb_edges)]++;
+		stats->string_bytes += strlen(v->content) + 1;
+		stats->edge_set_bytes += v->edge_set_size * sizeof(edge_t *);
+	}
+	for (v = graph->free_vertices; v != NULL; v = v->next)
+		stats->vertex_bytes += sizeof(*v);
+
+	stats->nb_vertices = graph->nb_vertices;
+	stats->nb_duplicate_edges = graph->nb_duplicate_edges;
+	stats->vertex_bytes += graph->nb_vertices * sizeof(vertex_t);
+	stats->edge_bytes = stats->nb_edges * sizeof(edge_t);
+	if (graph->track_in_edges)
+		stats->in_edge_bytes = stats->edge_bytes;
+	stats->index_bytes = graph->nb_buckets * sizeof(vertex_t *);
+	held_bytes(graph, stats);
+	return (1);
+}
@@ -0,0 +1,134 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/**
+ * struct tarjan_frame_s - Vertex being explored by Tarjan's algorithm
+ * @vertex: The vertex
+ * @edge: Next edge of the vertex to follow
+ */
+typedef struct tarjan_frame_s
+{
+	const vertex_t *vertex;
+	const edge_t *edge;
+} tarjan_frame_t;
+
+/**
+ * struct tarjan_s - State of Tarjan's algorithm, sized for nb_slots
+ * @num: Discovery order of each vertex index, from 1 (0 if not found yet)
+ * @low: Smallest discovery order reachable from each vertex's subtree
+ * @labels: Component of each vertex, GRAPH_LABEL_NONE until assigned
+ * @stack: Vertex indices found but not assigned to a component yet
+ * @depth: Number of indices in @stack
+ * @frames: The explicit call stack of the depth-first search
+ * @counter: Number of vertices found so far
+ * @nb: Number of components found so far
+ */
+typedef struct tarjan_s
+{
+	size_t *num;
+	size_t *low;
+	size_t *labels;
+	size_t *stack;
+	size_t depth;
+	tarjan_frame_t *frames;
+	size_t counter;
+	size_t nb;
+} tarjan_t;
+
+/**
+ * tarjan_enter - Discovers a vertex and pushes it on both stacks.
+ * @st: Pointer to the algorithm state.
+ * @vertex: The vertex.
+ * @top: Position of the vertex's frame in the call stack.
+ */
+static void tarjan_enter(tarjan_t *st, const vertex_t *vertex, size_t top)
+{
+	st->num[vertex->index] = st->low[vertex->index] = ++st->counter;
+	st->stack[st->depth++] = vertex->index;
+	st->frames[top].vertex = vertex;
+	st->frames[top].edge = vertex->edges;
+}
+
+/**
+ * tarjan_from - Runs the depth-first search of Tarjan's algorithm from a
+ * vertex, with an explicit call stack.
+ * @st: Pointer to the algorithm state.
+ * @root: The vertex to start from, not found yet.
+ */
+static void tarjan_from(tarjan_t *st, const vertex_t *root)
+{
+	size_t top = 0, v, w;
+	tarjan_frame_t *frame;
+	const vertex_t *dest;
+
+	tarjan_enter(st, root, 0);
+	while (1)
+	{
+		frame = &st->frames[top];
+		v = frame->vertex->index;
+		if (frame->edge != NULL)
+		{
+			dest = frame->edge->dest;
+			frame->edge = frame->edge->next;
+			if (st->num[dest->index] == 0)
+				tarjan_enter(st, dest, ++top);
+			else if (st->labels[dest->index] == GRAPH_LABEL_NONE &&
+					 st->num[dest->index] < st->low[v])
+				st->low[v] = st->num[dest->index]; /* Still on the stack */
+			continue;
+		}
+		if (st->low[v] == st->num[v])
+		{
+			do {
+				w = st->stack[--st->depth];
+				st->labels[w] = st->nb;
+			} while (w != v);
+			st->nb++;
+		}
+		if (top-- == 0)
+			return;
+		w = st->frames[top].vertex->index;
+		if (st->low[v] < st->low[w])
+			st->low[w] = st->low[v];
+	}
+}
+
+/**
+ * graph_strong_components - Labels the strongly connected components of a
+ * graph, using an iterative version of Tarjan's algorithm. Runs in linear
+ * time in the number of vertices and edges.
+ * @graph: Pointer to the graph.
+ * @labels: Array of graph->nb_slots entries, receiving the component of
+ * each vertex by vertex_s::index, or GRAPH_LABEL_NONE for indices no
+ * vertex holds. Components are numbered from 0 in reverse topological
+ * order: an edge between two components always goes from the higher
+ * label to the lower one.
+ * Return: The number of components, or 0 on failure.
+ */
+size_t graph_strong_components(const graph_t *graph, size_t *labels)
+{
+	tarjan_t st;
+	const vertex_t *v;
+	size_t i, n;
+
+	if (graph == NULL || labels == NULL || graph->vertices == NULL)
+		return (0);
+
+	n = graph->nb_slots;
+	st.num = calloc(n, sizeof(*st.num));
+	st.low = malloc(sizeof(*st.low) * n);
+	st.stack = malloc(sizeof(*st.stack) * graph->nb_vertices);
+	st.frames = malloc(sizeof(*st.frames) * graph->nb_vertices);
+	st.labels = labels;
+	st.depth = st.counter = st.nb = 0;
+	if (st.num && st.low && st.stack && st.frames)
+	{
+		for (i = 0; i < n; i++)
+			labels[i] = GRAPH_LABEL_NONE;
+		for (v = graph->vertices; v != NULL; v = v->next)
+			if (st.num[v->index] == 0)
+				tarjan_from(&st, v);
+	}
+	free(st.num), free(st.low), free(st.stack), free(st.frames);
+	return (st.nb);
+}
@@ -0,0 +1,167 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+#define TOPO_DONE ((size_t)-2) /* Sorted, or explored without a cycle */
+#define TOPO_NEW ((size_t)-1) /* Not sorted, not explored yet */
+
+/**
+ * struct topo_frame_s - Vertex being explored by the cycle search
+ * @vertex: The vertex
+ * @edge: Next edge of the vertex to follow
+ */
+typedef struct topo_frame_s
+{
+	const vertex_t *vertex;
+	const edge_t *edge;
+} topo_frame_t;
+
+/**
+ * kahn_levels - Sorts the vertices with Kahn's algorithm, one level at a
+ * time: a level holds the vertices whose predecessors are all in earlier
+ * levels, in the order they became ready.
+ * @graph: Pointer to the graph.
+ * @topo: The result to fill.
+ * @indeg: Zeroed array of nb_slots entries, receiving the number of
+ * incoming edges of each vertex index, counted down as they are sorted.
+ * @queue: Room for the sorted vertices (nb_vertices), in @topo's order.
+ */
+static void kahn_levels(const graph_t *graph, graph_topo_t *topo,
+						size_t *indeg, const vertex_t **queue)
+{
+	const vertex_t *v;
+	const edge_t *edge;
+	size_t head = 0, level_end;
+
+	for (v = graph->vertices; v != NULL; v = v->next)
+		for (edge = v->edges; edge != NULL; edge = edge->next)
+			indeg[edge->dest->index]++;
+	for (v = graph->vertices; v != NULL; v = v->next)
+		if (indeg[v->index] == 0)
+			queue[topo->nb_sorted++] = v;
+
+	while (head < topo->nb_sorted)
+	{
+		level_end = topo->nb_sorted;
+		for (; head < level_end; head++)
+		{
+			topo->order[head] = queue[head]->index;
+			for (edge = queue[head]->edges; edge != NULL; edge = edge->next)
+				if (--indeg[edge->dest->index] == 0)
+					queue[topo->nb_sorted++] = edge->dest;
+		}
+		topo->level_ends[topo->nb_levels++] = level_end;
+	}
+}
+
+/**
+ * find_cycle - Looks for a cycle among the vertices left unsorted, with
+ * an iterative depth-first search. Each of them has a predecessor left
+ * unsorted, so they always hold a cycle.
+ * @graph: Pointer to the graph.
+ * @topo: The result, whose cycle is filled.
+ * @mark: Per vertex index, TOPO_DONE for the sorted vertices and
+ * TOPO_NEW for the others. Vertices on the search path hold their depth.
+ * @frames: Room for the search path (nb_vertices).
+ */
+static void find_cycle(const graph_t *graph, graph_topo_t *topo,
+					   size_t *mark, topo_frame_t *frames)
+{
+	const vertex_t *v, *dest;
+	size_t top, i;
+
+	for (v = graph->vertices; v != NULL; v = v->next)
+	{
+		if (mark[v->index] != TOPO_NEW)
+			continue;
+		top = mark[v->index] = 0;
+		frames[0].vertex = v;
+		frames[0].edge = v->edges;
+		while (1)
+		{
+			if (frames[top].edge == NULL)
+			{
+				mark[frames[top].vertex->index] = TOPO_DONE;
+				if (top-- == 0)
+					break;
+				continue;
+			}
+			dest = frames[top].edge->dest;
+			frames[top].edge = frames[top].edge->next;
+			if (mark[dest->index] == TOPO_NEW)
+			{
+				mark[dest->index] = ++top;
+				frames[top].vertex = dest;
+				frames[top].edge = dest->edges;
+			}
+			else if (mark[dest->index] != TOPO_DONE)
+			{
+				for (i = mark[dest->index]; i <= top; i++)
+					topo->cycle[topo->cycle_len++] = frames[i].vertex->index;
+				return;
+			}
+		}
+	}
+}
+
+/**
+ * graph_topological_sort - Sorts the vertices of a graph so that every
+ * edge goes from a vertex to a later one, using Kahn's algorithm, in
+ * linear time. The vertices are grouped in levels of vertices that do not
+ * depend on each other, which can be processed in parallel once the
+ * previous levels are done. When the graph has a cycle, only the vertices
+ * that do not depend on it are sorted, and one cycle is reported.
+ * Meant for graphs with UNIDIRECTIONAL edges: a BIDIRECTIONAL edge is a
+ * cycle.
+ * @graph: Pointer to the graph to sort.
+ * Return: A pointer to the result, a single allocation to release with
+ * graph_topo_delete, or NULL on failure.
+ */
+graph_topo_t *graph_topological_sort(const graph_t *graph)
+{
+	graph_topo_t *topo;
+	const vertex_t **queue;
+	topo_frame_t *frames;
+	size_t *indeg, n, i;
+
+	if (graph == NULL)
+		return (NULL);
+	n = graph->nb_vertices ? graph->nb_vertices : 1;
+	topo = calloc(1, sizeof(*topo) + 3 * n * sizeof(size_t));
+	indeg = calloc(graph->nb_slots + 1, sizeof(*indeg));
+	queue = malloc(sizeof(*queue) * n);
+	if (topo == NULL || indeg == NULL || queue == NULL)
+	{
+		free(topo), free(indeg), free(queue);
+		return (NULL);
+	}
+	topo->order = (size_t *)(topo + 1);
+	topo->level_ends = topo->order + n;
+	topo->cycle = topo->level_ends + n;
+
+	kahn_levels(graph, topo, indeg, queue);
+	free(queue);
+	if (topo->nb_sorted < graph->nb_vertices)
+	{
+		frames = malloc(sizeof(*frames) * n);
+		if (frames == NULL)
+		{
+			free(topo), free(indeg);
+			return (NULL);
+		}
+		for (i = 0; i < graph->nb_slots; i++)
+			indeg[i] = indeg[i] ? TOPO_NEW : TOPO_DONE;
+		find_cycle(graph, topo, indeg, frames);
+		free(frames);
+	}
+	free(indeg);
+	return (topo);
+}
+
+/**
+ * graph_topo_delete - Deletes the result of a topological sort.
+ * @topo: Pointer to the result.
+ */
+void graph_topo_delete(graph_topo_t *topo)
+{
+	free(topo);
+}
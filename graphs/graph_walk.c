@@ -0,0 +1,91 @@
+#include <stdlib.h>
+#include <string.h>
+#include "graphs.h"
+
+#define WALK_STACK_MIN 64 /* Initial number of entries of the stack */
+#define WALK_MARKS_MIN 64 /* Initial number of entries of the marks */
+
+/**
+ * graph_walk_create - Creates the reusable state of the bounded walks.
+ * Nothing is allocated until the first walk.
+ * Return: A pointer to the state, or NULL on failure.
+ */
+graph_walk_t *graph_walk_create(void)
+{
+	return (calloc(1, sizeof(graph_walk_t)));
+}
+
+/**
+ * graph_walk_delete - Deletes the state of the bounded walks.
+ * @walk: Pointer to the state.
+ */
+void graph_walk_delete(graph_walk_t *walk)
+{
+	if (walk == NULL)
+		return;
+
+	free(walk->marks);
+	free(walk->stack);
+	free(walk->edges);
+	free(walk);
+}
+
+/**
+ * graph_walk_begin - Starts a new walk: every vertex becomes unvisited.
+ * Costs O(1), except when the graph has more vertex indices than the
+ * marks cover, or once every 2^32 - 1 walks when the epoch wraps around,
+ * where the marks are (re)cleared.
+ * @walk: Pointer to the state.
+ * @graph: Pointer to the graph about to be walked.
+ * Return: 1 on success, 0 on failure.
+ */
+int graph_walk_begin(graph_walk_t *walk, const graph_t *graph)
+{
+	uint32_t *marks;
+	size_t nb_marks;
+
+	if (graph->nb_slots > walk->nb_marks)
+	{
+		nb_marks = walk->nb_marks ? walk->nb_marks : WALK_MARKS_MIN;
+		while (nb_marks < graph->nb_slots)
+			nb_marks *= 2;
+		marks = realloc(walk->marks, sizeof(*marks) * nb_marks);
+		if (marks == NULL)
+			return (0);
+		memset(marks + walk->nb_marks, 0,
+			   sizeof(*marks) * (nb_marks - walk->nb_marks));
+		walk->marks = marks;
+		walk->nb_marks = nb_marks;
+	}
+	if (++walk->epoch == 0)
+	{
+		memset(walk->marks, 0, sizeof(*walk->marks) * walk->nb_marks);
+		walk->epoch = 1;
+	}
+	walk->nb_visited = 0;
+	walk->stopped = 0;
+	return (1);
+}
+
+/**
+ * graph_walk_grow - Doubles the room of the stack of the bounded walks.
+ * @walk: Pointer to the state.
+ * Return: 1 on success, 0 on failure.
+ */
+int graph_walk_grow(graph_walk_t *walk)
+{
+	const vertex_t **stack;
+	const edge_t **edges;
+	size_t size = walk->size ? walk->size * 2 : WALK_STACK_MIN;
+
+	stack = realloc(walk->stack, sizeof(*stack) * size);
+	if (stack == NULL)
+		return (0);
+	walk->stack = stack;
+	edges = realloc(walk->edges, sizeof(*edges) * size);
+	if (edges == NULL)
+		return (0);
+	walk->edges = edges;
+	walk->size = size;
+	return (1);
+}
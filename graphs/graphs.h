@@ -2,6 +2,61 @@
 #define GRAPHS_H
 
 #include <stddef.h> /* For size_t */
+#include <stdint.h> /* For uint32_t */
+
+/*
+ * Degree from which a vertex indexes its edges in an edge set, to detect
+ * duplicate edges without walking its edge list (must be a power of two)
+ */
+#define GRAPH_EDGE_SET_THRESHOLD 8
+
+/* Bit-packed sets of vertex indices, stored in arrays of unsigned long */
+#define GRAPH_BITS_WORD (8 * sizeof(unsigned long))
+#define GRAPH_BITS_SIZE(n) (((n) + GRAPH_BITS_WORD - 1) / GRAPH_BITS_WORD)
+#define GRAPH_BIT_TEST(set, i) \
+	((set)[(i) / GRAPH_BITS_WORD] >> ((i) % GRAPH_BITS_WORD) & 1)
+#define GRAPH_BIT_SET(set, i) \
+	((set)[(i) / GRAPH_BITS_WORD] |= 1UL << ((i) % GRAPH_BITS_WORD))
+
+/* Batched traversals: sources per batch, and depth of unreached vertices */
+#define GRAPH_BATCH_MAX 64
+#define GRAPH_DEPTH_NONE ((size_t)-1)
+
+/* Default number of visits handed at once to a chunked traversal action */
+#define GRAPH_VISIT_CHUNK 256
+
+/* Root of a frozen snapshot of a graph with no vertex */
+#define GRAPH_ROOT_NONE ((size_t)-1)
+
+/* Component label of the indices no vertex holds */
+#define GRAPH_LABEL_NONE ((size_t)-1)
+
+/* Default size of the slabs of an arena-backed graph */
+#define GRAPH_ARENA_SLAB_SIZE (1024 * 1024)
+
+/* Alignment of the nodes of an arena, and size of a slab's header */
+#define GRAPH_ARENA_ALIGN (2 * sizeof(void *))
+#define GRAPH_SLAB_HEADER \
+	((sizeof(graph_slab_t) + GRAPH_ARENA_ALIGN - 1) & ~(GRAPH_ARENA_ALIGN - 1))
+
+/* Number of buckets of the degree histogram of graph_stats */
+#define GRAPH_STATS_DEGREE_BUCKETS (8 * sizeof(size_t) + 1)
+
+/*
+ * Binary edge-list files start with this magic, followed by the number of
+ * vertices (uint32) and of edges (uint64), then one (src, dest) pair of
+ * uint32 vertex ids per edge. Every integer is stored little-endian
+ */
+#define GRAPH_EDGELIST_MAGIC "GEL1"
+
+/* Graph image files (see graph_save) */
+#define GRAPH_IMAGE_MAGIC "GRAPHIMG"
+#define GRAPH_IMAGE_VERSION 3
+#if UINTPTR_MAX > 0xffffffffu
+#define GRAPH_IMAGE_BASE ((uintptr_t)0x200000000000) /* Preferred address */
+#else
+#define GRAPH_IMAGE_BASE ((uintptr_t)0)
+#endif
 
 /**
  * enum edge_type_e - Enumerates the different types of
@@ -16,6 +71,33 @@ typedef enum edge_type_e
 	BIDIRECTIONAL
 } edge_type_t;
 
+/**
+ * enum graph_walk_action_e - What a walk does after its action returns
+ *
+ * @GRAPH_WALK_CONTINUE: Go on, following the edges of the vertex
+ * @GRAPH_WALK_SKIP: Go on, without following the edges of the vertex
+ * @GRAPH_WALK_STOP: Stop the walk right away
+ */
+typedef enum graph_walk_action_e
+{
+	GRAPH_WALK_CONTINUE = 0,
+	GRAPH_WALK_SKIP,
+	GRAPH_WALK_STOP
+} graph_walk_action_t;
+
+/**
+ * enum graph_order_e - Order in which graph_reorder lays out the vertices
+ *
+ * @GRAPH_ORDER_BFS: Breadth-first order, from the first vertex
+ * @GRAPH_ORDER_RCM: Reverse Cuthill-McKee order, which keeps the indices
+ * of neighbours close (small bandwidth)
+ */
+typedef enum graph_order_e
+{
+	GRAPH_ORDER_BFS = 0,
+	GRAPH_ORDER_RCM
+} graph_order_t;
+
 /* Define the structure temporarily for usage in the edge_t */
 typedef struct vertex_s vertex_t;
 
@@ -25,11 +107,14 @@ typedef struct vertex_s vertex_t;
  *
  * @dest: Pointer to the connected vertex
  * @next: Pointer to the next edge
+ * @weight: Cost of going through the edge (1 unless set with
+ * graph_add_edge_weighted)
  */
 typedef struct edge_s
 {
 	vertex_t *dest;
 	struct edge_s *next;
+	int weight;
 } edge_t;
 
 /**
@@ -39,9 +124,18 @@ typedef struct edge_s
  * @content: Custom data stored in the vertex (here, a string)
  * @nb_edges: Number of conenctions with other vertices in the graph
  * @edges: Pointer to the head node of the linked list of edges
+ * @edges_tail: Pointer to the last node of the linked list of edges
+ * @edge_set: Open-addressing hash set of the edges, keyed by destination
+ * (NULL while @nb_edges is below GRAPH_EDGE_SET_THRESHOLD)
+ * @edge_set_size: Number of slots in @edge_set
+ * @in_edges: Linked list of the incoming edges, each stored as an edge_t
+ * whose @dest is the source vertex, with the edge's weight (only
+ * maintained once the graph tracks incoming edges, see
+ * graph_track_in_edges)
  * @next: Pointer to the next vertex in the adjacency linked list
  * This pointer points to another vertex in the graph, but it
  * doesn't stand for an edge between the two vertices
+ * @prev: Pointer to the previous vertex in the adjacency linked list
  */
 struct vertex_s
 {
@@ -49,29 +143,354 @@ struct vertex_s
 	char *content;
 	size_t nb_edges;
 	edge_t *edges;
+	edge_t *edges_tail;
+	edge_t **edge_set;
+	size_t edge_set_size;
+	edge_t *in_edges;
 	struct vertex_s *next;
+	struct vertex_s *prev;
 };
 
+/**
+ * struct graph_slab_s - Block of memory an arena hands out sequentially
+ *
+ * @next: Pointer to the previously filled slab
+ * @size: Number of usable bytes following the header
+ * @used: Number of bytes already handed out
+ */
+typedef struct graph_slab_s
+{
+	struct graph_slab_s *next;
+	size_t size;
+	size_t used;
+} graph_slab_t;
+
+/**
+ * struct graph_arena_s - Slab allocator backing the vertices, edges and
+ * content strings of a graph. Nothing is freed individually: every slab
+ * is released at once when the graph is deleted
+ *
+ * @slabs: Pointer to the slab currently being filled
+ * @slab_size: Size of a regular slab
+ */
+typedef struct graph_arena_s
+{
+	graph_slab_t *slabs;
+	size_t slab_size;
+} graph_arena_t;
+
 /**
  * struct graph_s - Representation of a graph
  * We use an adjacency linked list to represent our graph
  *
  * @nb_vertices: Number of vertices in our graph
+ * @nb_slots: Number of vertex indices handed out so far. Every index is
+ * below it, so arrays indexed by vertex_s::index need @nb_slots entries
+ * (more than @nb_vertices once vertices were removed and not replaced)
  * @vertices: Pointer to the head node of our adjacency linked list
+ * @vertices_tail: Pointer to the last node of our adjacency linked list
+ * @free_vertices: Removed vertices, linked through @next, whose memory
+ * and index are reused by the next vertices added
+ * @track_in_edges: Set once the vertices' @in_edges lists are maintained
+ * @nb_duplicate_edges: Number of edges that were not added because they
+ * already existed
+ * @buckets: Open-addressing hash index of the vertices, keyed by content
+ * @nb_buckets: Number of slots in @buckets (0 or a power of two)
+ * @arena: Allocator of the vertices, edges and strings, or NULL when
+ * they are allocated one by one with malloc
+ * @mapping: Base address of the read-only image the graph lives in
+ * (see graph_mmap_open), or NULL
+ * @mapping_size: Size of the image in bytes
  */
 typedef struct graph_s
 {
 	size_t nb_vertices;
+	size_t nb_slots;
 	vertex_t *vertices;
+	vertex_t *vertices_tail;
+	vertex_t *free_vertices;
+	int track_in_edges;
+	size_t nb_duplicate_edges;
+	vertex_t **buckets;
+	size_t nb_buckets;
+	graph_arena_t *arena;
+	void *mapping;
+	size_t mapping_size;
 } graph_t;
 
+/**
+ * struct graph_image_s - Header of a graph image file. The image is the
+ * graph_t, the vertices (one slot per index), the edges, the hash index
+ * and the content strings, stored as they sit in memory with pointers
+ * encoded for a mapping at address @base
+ *
+ * @magic: GRAPH_IMAGE_MAGIC
+ * @version: GRAPH_IMAGE_VERSION
+ * @byte_order: 0x01020304, as written by the host that saved the image
+ * @word_size: sizeof(void *) on the host that saved the image
+ * @reserved: Padding, zero
+ * @base: Address the pointers of the image are encoded for
+ * @size: Size of the whole image in bytes
+ * @nb_slots: Number of vertex slots
+ * @nb_edges: Number of edges
+ * @graph: Offset of the graph_t
+ * @vertices: Offset of the array of vertices
+ * @edges: Offset of the array of edges
+ * @buckets: Offset of the hash index
+ * @strings: Offset of the content strings
+ */
+typedef struct graph_image_s
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	uint32_t word_size;
+	uint32_t reserved;
+	uint64_t base;
+	uint64_t size;
+	uint64_t nb_slots;
+	uint64_t nb_edges;
+	uint64_t graph;
+	uint64_t vertices;
+	uint64_t edges;
+	uint64_t buckets;
+	uint64_t strings;
+} graph_image_t;
+
+/**
+ * struct graph_csr_s - Frozen, read-only snapshot of a graph in compressed
+ * sparse row form. The edges of the vertex of index i are the destination
+ * indices targets[offsets[i]] to targets[offsets[i + 1] - 1], in the order
+ * of its edge list.
+ * The snapshot points to the vertices of the graph it was built from, so
+ * that graph must outlive it and must not be modified while it is in use
+ *
+ * @nb_vertices: Number of vertex indices in the snapshot (graph_s::nb_slots),
+ * the indices of removed vertices having no vertex and no edges
+ * @nb_edges: Number of edges in the snapshot
+ * @root: Index of the first vertex of the adjacency linked list, or
+ * GRAPH_ROOT_NONE when the graph has no vertex left
+ * @offsets: Start of the edges of each vertex in @targets (@nb_vertices + 1)
+ * @targets: Destination index of each edge (@nb_edges)
+ * @weights: Weight of each edge, in the order of @targets (@nb_edges).
+ * Kept apart so that unweighted traversals only stream through @targets
+ * @vertices: Vertex of each index, or NULL (@nb_vertices)
+ * @rev_offsets: Start of the incoming edges of each vertex in @rev_sources
+ * (@nb_vertices + 1), or NULL until graph_csr_reverse is called
+ * @rev_sources: Source index of each incoming edge (@nb_edges), or NULL
+ */
+typedef struct graph_csr_s
+{
+	size_t nb_vertices;
+	size_t nb_edges;
+	size_t root;
+	size_t *offsets;
+	uint32_t *targets;
+	int *weights;
+	const vertex_t **vertices;
+	size_t *rev_offsets;
+	uint32_t *rev_sources;
+} graph_csr_t;
+
+/**
+ * struct graph_visit_s - Vertex reached by a traversal, as handed in
+ * arrays to the action of the chunked traversals
+ *
+ * @vertex: The visited vertex
+ * @depth: Its depth, from the starting vertex
+ */
+typedef struct graph_visit_s
+{
+	const vertex_t *vertex;
+	size_t depth;
+} graph_visit_t;
+
+/**
+ * struct graph_walk_s - Reusable state of the bounded walks
+ * (depth_first_walk, breadth_first_walk). A vertex is marked visited by
+ * storing the current epoch in its mark, so starting a walk forgets the
+ * previous one by bumping the epoch rather than clearing every mark, and
+ * the stack only grows to what the walks actually touch
+ *
+ * @marks: Epoch of the last walk that visited each vertex index
+ * @nb_marks: Number of entries in @marks
+ * @epoch: Epoch of the current walk
+ * @stack: Queue or stack of the vertices to explore
+ * @edges: Next edge to follow of each vertex of @stack (depth-first)
+ * @size: Number of entries allocated in @stack and @edges
+ * @nb_visited: Number of vertices the last walk visited
+ * @stopped: Set if the last walk was stopped by its action
+ */
+typedef struct graph_walk_s
+{
+	uint32_t *marks;
+	size_t nb_marks;
+	uint32_t epoch;
+	const vertex_t **stack;
+	const edge_t **edges;
+	size_t size;
+	size_t nb_visited;
+	int stopped;
+} graph_walk_t;
+
+/**
+ * struct graph_stats_s - Figures about a graph, gathered by graph_stats.
+ * Byte counts are the sizes requested for each kind of node; arenas add
+ * alignment padding and unused slab space on top, which @total_bytes
+ * accounts for
+ *
+ * @nb_vertices: Number of vertices
+ * @nb_edges: Number of edges (a BIDIRECTIONAL edge counts twice)
+ * @nb_duplicate_edges: Number of edges not added because they already
+ * existed. The share of edges lost to duplicate suppression is
+ * @nb_duplicate_edges / (@nb_edges + @nb_duplicate_edges)
+ * @max_degree: Biggest number of edges leaving a vertex
+ * @degrees: Histogram of the vertex degrees: degrees[0] counts the
+ * vertices without edges, degrees[k] those with 2^(k-1) to 2^k - 1 edges
+ * @vertex_bytes: Memory of the vertices, removed ones awaiting reuse
+ * included
+ * @edge_bytes: Memory of the edges
+ * @in_edge_bytes: Memory of the incoming edge lists, if tracked
+ * @string_bytes: Memory of the content strings
+ * @edge_set_bytes: Memory of the vertices' edge sets
+ * @index_bytes: Memory of the hash index of the vertices
+ * @total_bytes: Memory held by the graph: the graph_t, the hash index,
+ * and either the whole slabs of its arena, the whole image it is mapped
+ * from, or the sum of the above
+ */
+typedef struct graph_stats_s
+{
+	size_t nb_vertices;
+	size_t nb_edges;
+	size_t nb_duplicate_edges;
+	size_t max_degree;
+	size_t degrees[GRAPH_STATS_DEGREE_BUCKETS];
+	size_t vertex_bytes;
+	size_t edge_bytes;
+	size_t in_edge_bytes;
+	size_t string_bytes;
+	size_t edge_set_bytes;
+	size_t index_bytes;
+	size_t total_bytes;
+} graph_stats_t;
+
+/**
+ * struct graph_topo_s - Result of a topological sort, allocated in one
+ * block by graph_topological_sort and released with graph_topo_delete
+ *
+ * @order: Vertex indices in topological order, level after level
+ * @nb_sorted: Number of indices in @order, lower than the number of
+ * vertices when the graph has a cycle
+ * @level_ends: End of each level in @order. Level l spans order[s] to
+ * order[level_ends[l] - 1], s being 0 for level 0 and level_ends[l - 1]
+ * otherwise. No edge joins two vertices of the same level
+ * @nb_levels: Number of levels
+ * @cycle: Vertex indices of a cycle, each having an edge to the next and
+ * the last one to the first, if the graph has a cycle
+ * @cycle_len: Number of indices in @cycle, 0 if the graph has no cycle
+ */
+typedef struct graph_topo_s
+{
+	size_t *order;
+	size_t nb_sorted;
+	size_t *level_ends;
+	size_t nb_levels;
+	size_t *cycle;
+	size_t cycle_len;
+} graph_topo_t;
+
+/* Pool of worker threads, see graph_pool.c */
+typedef struct graph_pool_s graph_pool_t;
+
 /* Function Prototypes */
 graph_t *graph_create(void);
 vertex_t *graph_add_vertex(graph_t *graph, const char *str);
 int graph_add_edge(graph_t *graph, const char *src, const char *dest, edge_type_t type);
+int graph_add_edge_weighted(graph_t *graph, const char *src, const char *dest, int weight, edge_type_t type);
 void graph_delete(graph_t *graph);
 size_t depth_first_traverse(const graph_t *graph, void (*action)(const vertex_t *v, size_t depth));
 size_t breadth_first_traverse(const graph_t *graph, void (*action)(const vertex_t *v, size_t depth));
 
+/* Removal */
+int graph_unlink_vertices(graph_t *graph, vertex_t *src_v, vertex_t *dest_v, edge_type_t type);
+int graph_remove_edge(graph_t *graph, const char *src, const char *dest, edge_type_t type);
+int graph_remove_vertex(graph_t *graph, const char *str);
+int graph_track_in_edges(graph_t *graph);
+int graph_in_edge_insert(graph_t *graph, vertex_t *src, const edge_t *edge);
+void graph_in_edge_remove(graph_t *graph, vertex_t *dest, const vertex_t *src);
+
+/* Bulk loading */
+vertex_t *graph_insert_vertex(graph_t *graph, const char *str);
+int graph_link_vertices(graph_t *graph, vertex_t *src_v, vertex_t *dest_v, edge_type_t type);
+int graph_link_vertices_weighted(graph_t *graph, vertex_t *src_v, vertex_t *dest_v, int weight, edge_type_t type);
+graph_t *graph_load_edgelist(const char *path, edge_type_t type);
+
+/* Images */
+int graph_save(const graph_t *graph, const char *path);
+graph_t *graph_mmap_open(const char *path);
+int graph_image_check(const graph_image_t *img, const char *map);
+
+/* Arena */
+graph_t *graph_create_arena(size_t slab_size);
+void *graph_alloc(graph_t *graph, size_t size);
+char *graph_strdup(graph_t *graph, const char *str);
+void graph_free(graph_t *graph, void *ptr);
+void graph_arena_delete(graph_arena_t *arena);
+
+/* Frozen snapshot */
+graph_csr_t *graph_freeze(const graph_t *graph);
+void graph_csr_delete(graph_csr_t *csr);
+int graph_csr_reverse(graph_csr_t *csr);
+size_t csr_depth_first_traverse(const graph_csr_t *csr, void (*action)(const vertex_t *v, size_t depth));
+size_t csr_breadth_first_traverse(const graph_csr_t *csr, void (*action)(const vertex_t *v, size_t depth));
+size_t csr_breadth_first_traverse_diropt(const graph_csr_t *csr, void (*action)(const vertex_t *v, size_t depth));
+size_t breadth_first_traverse_diropt(const graph_t *graph, void (*action)(const vertex_t *v, size_t depth));
+
+/* Chunked traversals */
+size_t depth_first_traverse_chunked(const graph_t *graph, void (*action)(const graph_visit_t *visits, size_t nb_visits, void *arg), void *arg, size_t chunk);
+size_t breadth_first_traverse_chunked(const graph_t *graph, void (*action)(const graph_visit_t *visits, size_t nb_visits, void *arg), void *arg, size_t chunk);
+
+/* Bounded walks */
+graph_walk_t *graph_walk_create(void);
+void graph_walk_delete(graph_walk_t *walk);
+int graph_walk_begin(graph_walk_t *walk, const graph_t *graph);
+int graph_walk_grow(graph_walk_t *walk);
+size_t depth_first_walk(const graph_t *graph, graph_walk_t *walk, const vertex_t *start, size_t max_depth, graph_walk_action_t (*action)(const vertex_t *v, size_t depth, void *arg), void *arg);
+size_t breadth_first_walk(const graph_t *graph, graph_walk_t *walk, const vertex_t *start, size_t max_depth, graph_walk_action_t (*action)(const vertex_t *v, size_t depth, void *arg), void *arg);
+
+/* Batched traversals */
+size_t breadth_first_traverse_batch(const graph_t *graph, const vertex_t *const *sources, size_t nb_sources, size_t *depths, void (*action)(const vertex_t *v, size_t source, size_t depth));
+
+/* Parallel traversals */
+graph_pool_t *graph_pool_create(size_t *nb_threads);
+void graph_pool_run(graph_pool_t *pool, void (*task)(void *arg, size_t thread_id), void *arg);
+void graph_pool_delete(graph_pool_t *pool);
+size_t breadth_first_traverse_parallel(const graph_t *graph, void (*action)(const vertex_t *v, size_t depth), size_t nb_threads);
+
+/* Components */
+size_t graph_components_relabel(const graph_t *graph, const size_t *roots, size_t *labels);
+size_t graph_components(const graph_t *graph, size_t *labels);
+size_t graph_components_parallel(const graph_t *graph, size_t *labels, size_t nb_threads);
+size_t graph_strong_components(const graph_t *graph, size_t *labels);
+
+/* Ordering */
+graph_topo_t *graph_topological_sort(const graph_t *graph);
+void graph_topo_delete(graph_topo_t *topo);
+int graph_reorder(graph_t *graph, graph_order_t order);
+
+/* Statistics */
+int graph_stats(const graph_t *graph, graph_stats_t *stats);
+
+/* Vertex index */
+size_t graph_hash_string(const char *str);
+vertex_t *graph_find_vertex(const graph_t *graph, const char *str);
+int graph_index_reserve(graph_t *graph, size_t nb_vertices);
+int graph_index_insert(graph_t *graph, vertex_t *vertex);
+
+/* Edge set */
+size_t graph_edge_slot(const vertex_t *dest, size_t mask);
+edge_t *graph_find_edge(const vertex_t *src, const vertex_t *dest);
+int graph_edge_set_insert(graph_t *graph, vertex_t *src, edge_t *edge);
+
 
 #endif /* GRAPHS_H */
\ No newline at end of file
@@ -27,10 +27,12 @@ static point_t *create_point(int x, int y)
  * @target: Target coordinates
  * @visited: 2D array marking visited cells
  * @path: Queue to store the path
+ * @trace: Trace of the search
  * Return: 1 if a path is found, otherwise 0
  */
 static int backtrack_recursive(char **map, int rows, int cols,
-							   point_t const *curr, point_t const *target, char **visited, queue_t *path)
+							   point_t const *curr, point_t const *target, char **visited, queue_t *path,
+							   path_trace_t *trace)
 {
 	int move_x[] = {1, 0, -1, 0}; /* R, B, L, T */
 	int move_y[] = {0, 1, 0, -1};
@@ -41,7 +43,7 @@ static int backtrack_recursive(char **map, int rows, int cols,
 		map[curr->y][curr->x] == '1' || visited[curr->y][curr->x] == 1)
 		return (0);
 
-	printf("Checking coordinates [%d, %d]\n", curr->x, curr->y);
+	PATH_TRACE_CELL(*trace, curr->x, curr->y);
 	visited[curr->y][curr->x] = 1;
 
 	if (curr->x == target->x && curr->y == target->y)
@@ -54,7 +56,9 @@ static int backtrack_recursive(char **map, int rows, int cols,
 	{
 		next.x = curr->x + move_x[i];
 		next.y = curr->y + move_y[i];
-		if (backtrack_recursive(map, rows, cols, &next, target, visited, path))
+		PATH_TRACE_RELAX(*trace);
+		if (backtrack_recursive(map, rows, cols, &next, target, visited, path,
+								trace))
 		{
 			queue_push_front(path, create_point(curr->x, curr->y));
 			return (1);
@@ -78,6 +82,7 @@ queue_t *backtracking_array(char **map, int rows, int cols,
 {
 	queue_t *path;
 	char **visited;
+	path_trace_t trace;
 	int i;
 
 	if (!map || !start || !target)
@@ -106,11 +111,14 @@ queue_t *backtracking_array(char **map, int rows, int cols,
 		}
 	}
 
-	if (!backtrack_recursive(map, rows, cols, start, target, visited, path))
+	PATH_TRACE_BEGIN(trace, "backtracking_array");
+	if (!backtrack_recursive(map, rows, cols, start, target, visited, path,
+							 &trace))
 	{
 		queue_delete(path);
 		path = NULL;
 	}
+	PATH_TRACE_END(trace);
 
 	for (i = 0; i < rows; i++)
 		free(visited[i]);
@@ -7,17 +7,19 @@
  * @target: Target vertex
  * @visited: Array marking visited vertices by their index
  * @path: Queue to store the path
+ * @trace: Trace of the search
  * Return: 1 if a path is found, otherwise 0
  */
 static int backtrack_graph_recursive(vertex_t const *curr,
-									 vertex_t const *target, char *visited, queue_t *path)
+									 vertex_t const *target, char *visited, queue_t *path,
+									 path_trace_t *trace)
 {
 	edge_t *edge;
 
 	if (!curr || visited[curr->index])
 		return (0);
 
-	printf("Checking %s\n", curr->content);
+	PATH_TRACE_VERTEX(*trace, curr, NULL, 0, 0);
 	visited[curr->index] = 1;
 
 	if (curr == target)
@@ -28,7 +30,9 @@ static int backtrack_graph_recursive(vertex_t const *curr,
 
 	for (edge = curr->edges; edge; edge = edge->next)
 	{
-		if (backtrack_graph_recursive(edge->dest, target, visited, path))
+		PATH_TRACE_RELAX(*trace);
+		if (backtrack_graph_recursive(edge->dest, target, visited, path,
+									  trace))
 		{
 			queue_push_front(path, strdup(curr->content));
 			return (1);
@@ -49,6 +53,7 @@ queue_t *backtracking_graph(graph_t *graph, vertex_t const *start,
 {
 	queue_t *path;
 	char *visited;
+	path_trace_t trace;
 
 	if (!graph || !start || !target)
 		return (NULL);
@@ -57,18 +62,20 @@ queue_t *backtracking_graph(graph_t *graph, vertex_t const *start,
 	if (!path)
 		return (NULL);
 
-	visited = calloc(graph->nb_vertices, sizeof(char));
+	visited = calloc(graph->nb_slots, sizeof(char));
 	if (!visited)
 	{
 		free(path);
 		return (NULL);
 	}
 
-	if (!backtrack_graph_recursive(start, target, visited, path))
+	PATH_TRACE_BEGIN(trace, "backtracking_graph");
+	if (!backtrack_graph_recursive(start, target, visited, path, &trace))
 	{
 		queue_delete(path);
 		path = NULL;
 	}
+	PATH_TRACE_END(trace);
 
 	free(visited);
 	return (path);
@@ -1,89 +1,60 @@
 #include "pathfinding.h"
-#include <string.h>
 #include <limits.h>
 
 /**
- * struct path_node_s - A node for a temporary path linked list
- * @vertex: Pointer to a graph vertex
- * @next: Pointer to the next node in the list
+ * struct dijkstra_s - State of a search
+ * @dist: Distance from the start of each vertex index, INT_MAX if unknown
+ * @pred: Previous vertex on the shortest path to each vertex index
+ * @verts: Vertex of each index reached so far, for O(1) lookups
+ * @heap: Vertex indices to settle, keyed by @dist
+ * @trace: Trace of the search
  */
-typedef struct path_node_s
+typedef struct dijkstra_s
 {
-	vertex_t const *vertex;
-	struct path_node_s *next;
-} path_node_t;
+	int *dist;
+	vertex_t const **pred;
+	vertex_t const **verts;
+	min_heap_t *heap;
+	path_trace_t trace;
+} dijkstra_t;
 
 /**
- * get_vertex_by_index - Retrieves a vertex from a graph by its index.
- * @graph: Pointer to the graph.
- * @index: The index of the vertex to find.
- *
- * Return: Pointer to the vertex, or NULL if not found.
- */
-static vertex_t *get_vertex_by_index(const graph_t *graph, size_t index)
-{
-	vertex_t *v;
-
-	if (!graph)
-		return (NULL);
-	v = graph->vertices;
-	while (v)
-	{
-		if (v->index == index)
-			return (v);
-		v = v->next;
-	}
-	return (NULL);
-}
-
-/**
- * free_path_list - Frees a temporary path linked list.
- * @head: Pointer to the head of the list.
- */
-static void free_path_list(path_node_t *head)
-{
-	path_node_t *tmp;
-
-	while (head)
-	{
-		tmp = head;
-		head = head->next;
-		free(tmp);
-	}
-}
-
-/**
- * create_path_queue - Creates a queue containing the path from a linked list.
- * @head: Head of the path linked list (in correct order: start -> target).
- *
- * Return: A queue with the path, or NULL on failure.
+ * dijkstra_search - Settles the vertices by increasing distance from the
+ * start, until the target is reached, taking the closest vertex out of an
+ * indexed binary heap: O((V + E) log V).
+ * @st: The search state, with every distance set to INT_MAX.
+ * @start: Pointer to the starting vertex.
+ * @target: Pointer to the target vertex.
  */
-static queue_t *create_path_queue(path_node_t *head)
+static void dijkstra_search(dijkstra_t *st, vertex_t const *start,
+							vertex_t const *target)
 {
-	queue_t *path = queue_create();
-	path_node_t *curr = head;
-	char *content_copy;
-
-	if (!path)
-		return (NULL);
+	vertex_t const *u;
+	edge_t *edge;
+	size_t u_idx, v_idx;
 
-	while (curr)
+	st->dist[start->index] = 0;
+	st->verts[start->index] = start;
+	min_heap_push(st->heap, start->index);
+	while ((u_idx = min_heap_pop(st->heap)) != MIN_HEAP_NONE)
 	{
-		content_copy = strdup(curr->vertex->content);
-		if (!content_copy)
-		{
-			queue_delete(path);
-			return (NULL);
-		}
-		if (!queue_push_back(path, content_copy))
+		u = st->verts[u_idx];
+		PATH_TRACE_VERTEX(st->trace, u, start, 0, st->dist[u_idx]);
+		if (u == target)
+			break;
+		for (edge = u->edges; edge; edge = edge->next)
 		{
-			free(content_copy);
-			queue_delete(path);
-			return (NULL);
+			PATH_TRACE_RELAX(st->trace);
+			v_idx = edge->dest->index;
+			if (st->dist[u_idx] + edge->weight < st->dist[v_idx])
+			{
+				st->dist[v_idx] = st->dist[u_idx] + edge->weight;
+				st->pred[v_idx] = u;
+				st->verts[v_idx] = edge->dest;
+				min_heap_push(st->heap, v_idx);
+			}
 		}
-		curr = curr->next;
 	}
-	return (path);
 }
 
 /**
@@ -98,70 +69,31 @@ static queue_t *create_path_queue(path_node_t *head)
 queue_t *dijkstra_graph(graph_t *graph, vertex_t const *start,
 						vertex_t const *target)
 {
-	size_t nb_v, i, j, u_idx;
-	int *dist, *visited, min_dist;
-	vertex_t **pred, *u;
-	edge_t *edge;
+	size_t nb_v, i;
+	dijkstra_t st;
 	queue_t *path = NULL;
-	path_node_t *path_head = NULL, *new_node = NULL;
-	vertex_t const *curr;
 
 	if (!graph || !start || !target)
 		return (NULL);
-	nb_v = graph->nb_vertices;
-	dist = calloc(nb_v, sizeof(*dist));
-	visited = calloc(nb_v, sizeof(*visited));
-	pred = calloc(nb_v, sizeof(*pred));
-	if (!dist || !visited || !pred)
+	nb_v = graph->nb_slots;
+	st.dist = malloc(sizeof(*st.dist) * nb_v);
+	for (i = 0; st.dist && i < nb_v; i++)
+		st.dist[i] = INT_MAX;
+	st.pred = calloc(nb_v, sizeof(*st.pred));
+	st.verts = malloc(sizeof(*st.verts) * nb_v);
+	st.heap = st.dist ? min_heap_create(nb_v, st.dist) : NULL;
+	if (!st.dist || !st.pred || !st.verts || !st.heap)
 	{
-		free(dist), free(visited), free(pred);
+		free(st.dist), free(st.pred), free(st.verts);
+		min_heap_delete(st.heap);
 		return (NULL);
 	}
-	for (i = 0; i < nb_v; i++)
-		dist[i] = INT_MAX;
-	dist[start->index] = 0;
-	for (i = 0; i < nb_v; i++)
-	{
-		min_dist = INT_MAX, u_idx = (size_t)-1;
-		for (j = 0; j < nb_v; j++)
-			if (!visited[j] && dist[j] < min_dist)
-				min_dist = dist[j], u_idx = j;
-		if (u_idx == (size_t)-1 || dist[u_idx] == INT_MAX)
-			break;
-		u = get_vertex_by_index(graph, u_idx);
-		if (!u)
-			break;
-		visited[u_idx] = 1;
-		printf("Checking %s, distance from %s is %d\n",
-			   u->content, start->content, dist[u_idx]);
-		if (u == target)
-			break;
-		for (edge = u->edges; edge; edge = edge->next)
-			if (dist[u_idx] + edge->weight < dist[edge->dest->index])
-			{
-				dist[edge->dest->index] = dist[u_idx] + edge->weight;
-				pred[edge->dest->index] = u;
-			}
-	}
-	if (dist[target->index] != INT_MAX)
-	{
-		for (curr = target; curr; curr = pred[curr->index])
-		{
-			new_node = malloc(sizeof(*new_node));
-			if (!new_node)
-			{
-				free_path_list(path_head), path_head = NULL;
-				break;
-			}
-			new_node->vertex = curr, new_node->next = path_head;
-			path_head = new_node;
-		}
-		if (path_head)
-		{
-			path = create_path_queue(path_head);
-			free_path_list(path_head);
-		}
-	}
-	free(dist), free(visited), free(pred);
+	PATH_TRACE_BEGIN(st.trace, "dijkstra_graph");
+	dijkstra_search(&st, start, target);
+	PATH_TRACE_END(st.trace);
+	if (st.dist[target->index] != INT_MAX)
+		path = vertex_path(target, st.pred);
+	free(st.dist), free(st.pred), free(st.verts);
+	min_heap_delete(st.heap);
 	return (path);
 }
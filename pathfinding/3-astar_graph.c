@@ -0,0 +1,124 @@
+#include "pathfinding.h"
+#include <limits.h>
+
+/**
+ * struct astar_s - State of a search
+ * @dist: Distance from the start of each vertex index, INT_MAX if unknown
+ * @rank: Distance plus heuristic of each vertex index reached
+ * @pred: Previous vertex on the shortest path to each vertex index
+ * @verts: Vertex of each index reached so far, for O(1) lookups
+ * @heap: Vertex indices to expand, keyed by @rank
+ * @heuristic: Estimate of the distance left from a vertex to the target
+ * @arg: Argument passed to @heuristic
+ * @trace: Trace of the search
+ */
+typedef struct astar_s
+{
+	int *dist;
+	int *rank;
+	vertex_t const **pred;
+	vertex_t const **verts;
+	min_heap_t *heap;
+	int (*heuristic)(vertex_t const *v, vertex_t const *target, void *arg);
+	void *arg;
+	path_trace_t trace;
+} astar_t;
+
+/**
+ * astar_search - Expands the vertices by increasing distance from the
+ * start plus estimated distance to the target, until the target is
+ * reached. A vertex reached again through a shorter path is expanded
+ * again, so that the path found is the shortest with any admissible
+ * heuristic; with a consistent one, each vertex is expanded once.
+ * @st: The search state, with every distance set to INT_MAX.
+ * @start: Pointer to the starting vertex.
+ * @target: Pointer to the target vertex.
+ */
+static void astar_search(astar_t *st, vertex_t const *start,
+						 vertex_t const *target)
+{
+	vertex_t const *u;
+	edge_t *edge;
+	size_t u_idx, v_idx;
+
+	st->dist[start->index] = 0;
+	st->rank[start->index] = st->heuristic ?
+		st->heuristic(start, target, st->arg) : 0;
+	st->verts[start->index] = start;
+	min_heap_push(st->heap, start->index);
+	while ((u_idx = min_heap_pop(st->heap)) != MIN_HEAP_NONE)
+	{
+		u = st->verts[u_idx];
+		PATH_TRACE_VERTEX(st->trace, u, start, 0, st->dist[u_idx]);
+		if (u == target)
+			break;
+		for (edge = u->edges; edge; edge = edge->next)
+		{
+			PATH_TRACE_RELAX(st->trace);
+			v_idx = edge->dest->index;
+			if (st->dist[u_idx] + edge->weight >= st->dist[v_idx])
+				continue;
+			st->dist[v_idx] = st->dist[u_idx] + edge->weight;
+			st->rank[v_idx] = st->dist[v_idx] + (st->heuristic ?
+				st->heuristic(edge->dest, target, st->arg) : 0);
+			st->pred[v_idx] = u;
+			st->verts[v_idx] = edge->dest;
+			min_heap_push(st->heap, v_idx);
+		}
+	}
+}
+
+/**
+ * astar_graph - Searches for the shortest path from a start to a target
+ * vertex in a graph using the A* algorithm: like Dijkstra's, but vertices
+ * that look closer to the target are expanded first, which spares most of
+ * the vertices leading away from it.
+ * @graph: Pointer to the graph to go through.
+ * @start: Pointer to the starting vertex.
+ * @target: Pointer to the target vertex.
+ * @heuristic: Pointer to a function estimating the distance left from a
+ * vertex to @target (for example from coordinates stored with the
+ * vertices), or NULL to search like dijkstra_graph. The path is the
+ * shortest as long as the estimate never exceeds the actual distance.
+ * v -> The vertex.
+ * target -> @target.
+ * arg -> @arg.
+ * @arg: Argument passed to @heuristic.
+ *
+ * Return: A queue with the shortest path, or NULL on failure.
+ */
+queue_t *astar_graph(graph_t *graph, vertex_t const *start,
+					 vertex_t const *target,
+					 int (*heuristic)(vertex_t const *v,
+									  vertex_t const *target, void *arg),
+					 void *arg)
+{
+	astar_t st;
+	size_t nb_v, i;
+	queue_t *path = NULL;
+
+	if (!graph || !start || !target)
+		return (NULL);
+	nb_v = graph->nb_slots;
+	st.dist = malloc(sizeof(*st.dist) * nb_v);
+	st.rank = malloc(sizeof(*st.rank) * nb_v);
+	for (i = 0; st.rank && i < nb_v; i++)
+		st.rank[i] = INT_MAX;
+	st.pred = calloc(nb_v, sizeof(*st.pred));
+	st.verts = malloc(sizeof(*st.verts) * nb_v);
+	st.heap = st.rank ? min_heap_create(nb_v, st.rank) : NULL;
+	st.heuristic = heuristic, st.arg = arg;
+	if (st.dist && st.rank && st.pred && st.verts && st.heap)
+	{
+		for (i = 0; i < nb_v; i++)
+			st.dist[i] = INT_MAX;
+		PATH_TRACE_BEGIN(st.trace, "astar_graph");
+		astar_search(&st, start, target);
+		PATH_TRACE_END(st.trace);
+		if (st.dist[target->index] != INT_MAX)
+			path = vertex_path(target, st.pred);
+	}
+	free(st.dist), free(st.rank), free(st.pred), free(st.verts);
+	min_heap_delete(st.heap);
+	return (path);
+}
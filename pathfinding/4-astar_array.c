@@ -0,0 +1,193 @@
+#include "pathfinding.h"
+#include <limits.h>
+
+#define STRAIGHT_COST 10 /* Cost of a move to a side neighbour, octile */
+#define DIAGONAL_COST 14 /* Cost of a diagonal move: about 10 * sqrt(2) */
+
+/**
+ * struct astar_grid_s - State of a search in a two-dimensional array
+ * @map: The array, '1' marking blocked cells
+ * @rows: Number of rows of @map
+ * @cols: Number of columns of @map
+ * @metric: Moves and heuristic of the search
+ * @target: Coordinates of the target point
+ * @dist: Distance from the start of each cell (y * cols + x)
+ * @rank: Distance plus heuristic of each cell reached
+ * @from: Previous cell on the shortest path to each cell, or -1
+ * @heap: Cells to expand, keyed by @rank
+ * @trace: Trace of the search
+ */
+typedef struct astar_grid_s
+{
+	char **map;
+	int rows;
+	int cols;
+	astar_metric_t metric;
+	point_t target;
+	int *dist;
+	int *rank;
+	int *from;
+	min_heap_t *heap;
+	path_trace_t trace;
+} astar_grid_t;
+
+/**
+ * grid_estimate - Estimates the distance left from a cell to the target,
+ * never overestimating it.
+ * @st: The search state.
+ * @x: X coordinate of the cell.
+ * @y: Y coordinate of the cell.
+ *
+ * Return: The Manhattan distance, or the octile distance (straight moves
+ * along the longest side, diagonal moves along the shortest).
+ */
+static int grid_estimate(const astar_grid_t *st, int x, int y)
+{
+	int dx = abs(st->target.x - x), dy = abs(st->target.y - y);
+
+	if (st->metric == ASTAR_MANHATTAN)
+		return (dx + dy);
+	if (dx < dy)
+		return (STRAIGHT_COST * dy + (DIAGONAL_COST - STRAIGHT_COST) * dx);
+	return (STRAIGHT_COST * dx + (DIAGONAL_COST - STRAIGHT_COST) * dy);
+}
+
+/**
+ * grid_expand - Relaxes the moves out of a cell: to the side neighbours
+ * (right, bottom, left, top), and with the octile metric to the diagonal
+ * ones, unless that cuts the corner of a blocked cell.
+ * @st: The search state.
+ * @cell: The cell.
+ */
+static void grid_expand(astar_grid_t *st, int cell)
+{
+	static const int move_x[] = {1, 0, -1, 0, 1, -1, -1, 1};
+	static const int move_y[] = {0, 1, 0, -1, 1, 1, -1, -1};
+	int x = cell % st->cols, y = cell / st->cols, nx, ny, next, cost, i;
+
+	for (i = 0; i < (st->metric == ASTAR_MANHATTAN ? 4 : 8); i++)
+	{
+		nx = x + move_x[i], ny = y + move_y[i];
+		if (nx < 0 || nx >= st->cols || ny < 0 || ny >= st->rows ||
+			st->map[ny][nx] == '1')
+			continue;
+		if (i >= 4 && (st->map[y][nx] == '1' || st->map[ny][x] == '1'))
+			continue;
+		PATH_TRACE_RELAX(st->trace);
+		cost = st->metric == ASTAR_MANHATTAN ? 1 :
+			(i < 4 ? STRAIGHT_COST : DIAGONAL_COST);
+		next = ny * st->cols + nx;
+		if (st->dist[cell] + cost >= st->dist[next])
+			continue;
+		st->dist[next] = st->dist[cell] + cost;
+		st->rank[next] = st->dist[next] + grid_estimate(st, nx, ny);
+		st->from[next] = cell;
+		min_heap_push(st->heap, next);
+	}
+}
+
+/**
+ * grid_path - Builds the queue of the points of the path leading to a
+ * cell.
+ * @st: The search state.
+ * @cell: The last cell of the path.
+ *
+ * Return: A queue of points, or NULL on failure.
+ */
+static queue_t *grid_path(const astar_grid_t *st, int cell)
+{
+	queue_t *path = queue_create();
+	point_t *point;
+
+	if (!path)
+		return (NULL);
+	for (; cell != -1; cell = st->from[cell])
+	{
+		point = malloc(sizeof(*point));
+		if (!point || !queue_push_front(path, point))
+		{
+			free(point);
+			queue_delete(path);
+			return (NULL);
+		}
+		point->x = cell % st->cols;
+		point->y = cell / st->cols;
+	}
+	return (path);
+}
+
+/**
+ * grid_search - Expands the cells by increasing distance from the start
+ * plus estimated distance to the target, until the target is reached.
+ * @st: The search state.
+ * @start: Coordinates of the starting point.
+ *
+ * Return: A queue of points from start to target, or NULL if there is no
+ * path or on failure.
+ */
+static queue_t *grid_search(astar_grid_t *st, point_t const *start)
+{
+	int cell, goal = st->target.y * st->cols + st->target.x, i;
+
+	for (i = 0; i < st->rows * st->cols; i++)
+		st->dist[i] = INT_MAX, st->from[i] = -1;
+	cell = start->y * st->cols + start->x;
+	st->dist[cell] = 0;
+	st->rank[cell] = grid_estimate(st, start->x, start->y);
+	min_heap_push(st->heap, cell);
+	while ((cell = (int)min_heap_pop(st->heap)) != (int)MIN_HEAP_NONE)
+	{
+		PATH_TRACE_CELL(st->trace, cell % st->cols, cell / st->cols);
+		if (cell == goal)
+			return (grid_path(st, cell));
+		grid_expand(st, cell);
+	}
+	return (NULL);
+}
+
+/**
+ * astar_array - Searches for the shortest path from a start to a target
+ * point within a two-dimensional array, using the A* algorithm.
+ * @map: Pointer to a read-only two-dimensional array, '1' marking
+ * blocked cells
+ * @rows: Number of rows of map
+ * @cols: Number of columns of map
+ * @start: Coordinates of the starting point
+ * @target: Coordinates of the target point
+ * @metric: ASTAR_MANHATTAN to move to the 4 side neighbours only, with the
+ * Manhattan distance as heuristic, or ASTAR_OCTILE to also move
+ * diagonally (without cutting corners), with the octile distance
+ * Return: A queue of points from start to target, or NULL on failure
+ */
+queue_t *astar_array(char **map, int rows, int cols, point_t const *start,
+					 point_t const *target, astar_metric_t metric)
+{
+	astar_grid_t st;
+	queue_t *path = NULL;
+	size_t nb_cells, i;
+
+	if (!map || !start || !target || rows <= 0 || cols <= 0 ||
+		start->x < 0 || start->x >= cols || start->y < 0 || start->y >= rows ||
+		target->x < 0 || target->x >= cols || target->y < 0 ||
+		target->y >= rows || map[start->y][start->x] == '1' ||
+		map[target->y][target->x] == '1')
+		return (NULL);
+	nb_cells = (size_t)rows * cols;
+	st.map = map, st.rows = rows, st.cols = cols;
+	st.metric = metric, st.target = *target;
+	st.dist = malloc(sizeof(*st.dist) * nb_cells);
+	st.rank = malloc(sizeof(*st.rank) * nb_cells);
+	for (i = 0; st.rank && i < nb_cells; i++)
+		st.rank[i] = INT_MAX;
+	st.from = malloc(sizeof(*st.from) * nb_cells);
+	st.heap = st.rank ? min_heap_create(nb_cells, st.rank) : NULL;
+	if (st.dist && st.rank && st.from && st.heap)
+	{
+		PATH_TRACE_BEGIN(st.trace, "astar_array");
+		path = grid_search(&st, start);
+		PATH_TRACE_END(st.trace);
+	}
+	free(st.dist), free(st.rank), free(st.from);
+	min_heap_delete(st.heap);
+	return (path);
+}
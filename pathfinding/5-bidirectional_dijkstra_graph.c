@@ -0,0 +1,219 @@
+#include "pathfinding.h"
+#include <limits.h>
+#include <string.h>
+
+/**
+ * struct bidir_s - State of a bidirectional search. Side 0 searches
+ * forward from the start along the edges, side 1 backward from the
+ * target along the incoming edges.
+ * @dist: Per side, distance of each vertex index from the start (to the
+ * target), INT_MAX if unknown
+ * @link: Per side, next vertex towards the start (the target) on the
+ * shortest path found to each vertex index
+ * @verts: Vertex of each index reached so far, for O(1) lookups
+ * @heap: Per side, vertex indices to settle, keyed by @dist
+ * @in: Incoming edges of each vertex index, each stored as an edge_t whose
+ * dest is the source vertex, or NULL to use the vertices' in_edges lists
+ * @in_nodes: Storage of the entries of @in
+ * @best: Length of the shortest path found so far, INT_MAX if none
+ * @meet: Vertex where the searches met on that path
+ * @trace: Trace of the search
+ */
+typedef struct bidir_s
+{
+	int *dist[2];
+	vertex_t const **link[2];
+	vertex_t const **verts;
+	min_heap_t *heap[2];
+	edge_t **in;
+	edge_t *in_nodes;
+	long best;
+	vertex_t const *meet;
+	path_trace_t trace;
+} bidir_t;
+
+/**
+ * bidir_settle - Settles the closest vertex of one side, and relaxes its
+ * edges (forward) or incoming edges (backward), recording the shortest
+ * path through each edge leading to a vertex the other side reached.
+ * @st: The search state.
+ * @side: 0 for the forward search, 1 for the backward search.
+ * @from: The vertex the side started from, for the trace.
+ */
+static void bidir_settle(bidir_t *st, int side, vertex_t const *from)
+{
+	size_t u_idx = min_heap_pop(st->heap[side]), v_idx;
+	vertex_t const *u = st->verts[u_idx];
+	int *dist = st->dist[side], *other = st->dist[!side];
+	edge_t *edge;
+
+	(void)from; /* Only traced */
+	PATH_TRACE_VERTEX(st->trace, u, from, side, dist[u_idx]);
+	edge = side ? (st->in ? st->in[u_idx] : u->in_edges) : u->edges;
+	for (; edge; edge = edge->next)
+	{
+		PATH_TRACE_RELAX(st->trace);
+		v_idx = edge->dest->index;
+		if (dist[u_idx] + edge->weight < dist[v_idx])
+		{
+			dist[v_idx] = dist[u_idx] + edge->weight;
+			st->link[side][v_idx] = u;
+			st->verts[v_idx] = edge->dest;
+			min_heap_push(st->heap[side], v_idx);
+		}
+		if (other[v_idx] != INT_MAX &&
+			(long)dist[u_idx] + edge->weight + other[v_idx] < st->best)
+		{
+			st->best = (long)dist[u_idx] + edge->weight + other[v_idx];
+			st->meet = edge->dest;
+		}
+	}
+}
+
+/**
+ * bidir_reverse - Builds the incoming edges of every vertex for the
+ * backward search, in the same order as graph_track_in_edges would, so
+ * that the graph itself is left untouched.
+ * @st: The search state.
+ * @graph: Pointer to the graph.
+ *
+ * Return: 1 on success, 0 on failure.
+ */
+static int bidir_reverse(bidir_t *st, const graph_t *graph)
+{
+	const vertex_t *v;
+	edge_t *edge, *entry;
+	size_t nb_edges = 0;
+
+	for (v = graph->vertices; v; v = v->next)
+		nb_edges += v->nb_edges;
+	st->in = calloc(graph->nb_slots, sizeof(*st->in));
+	st->in_nodes = malloc(sizeof(*st->in_nodes) * (nb_edges ? nb_edges : 1));
+	if (!st->in || !st->in_nodes)
+		return (0);
+	entry = st->in_nodes;
+	for (v = graph->vertices; v; v = v->next)
+		for (edge = v->edges; edge; edge = edge->next, entry++)
+		{
+			entry->dest = (vertex_t *)v;
+			entry->weight = edge->weight;
+			entry->next = st->in[edge->dest->index];
+			st->in[edge->dest->index] = entry;
+		}
+	return (1);
+}
+
+/**
+ * bidir_search - Grows both searches, settling a vertex of the side whose
+ * next vertex is the closest, until no shorter path can be found: when
+ * the next distances of both sides add up to the best path found.
+ * @st: The search state, with every distance set to INT_MAX.
+ * @start: Pointer to the starting vertex.
+ * @target: Pointer to the target vertex.
+ */
+static void bidir_search(bidir_t *st, vertex_t const *start,
+						 vertex_t const *target)
+{
+	const min_heap_t *fw = st->heap[0], *bw = st->heap[1];
+	long top[2];
+	int side;
+
+	st->dist[0][start->index] = 0;
+	st->dist[1][target->index] = 0;
+	st->verts[start->index] = start;
+	st->verts[target->index] = target;
+	min_heap_push(st->heap[0], start->index);
+	min_heap_push(st->heap[1], target->index);
+	st->best = start == target ? 0 : INT_MAX;
+	st->meet = start == target ? start : NULL;
+	while (fw->size > 0 && bw->size > 0)
+	{
+		top[0] = st->dist[0][fw->nodes[0]];
+		top[1] = st->dist[1][bw->nodes[0]];
+		if (top[0] + top[1] >= st->best)
+			break;
+		side = top[1] < top[0];
+		bidir_settle(st, side, side ? target : start);
+	}
+}
+
+/**
+ * bidir_path - Builds the queue of the shortest path found: from the
+ * start to the meeting vertex, then on to the target.
+ * @st: The search state.
+ *
+ * Return: A queue with the path, or NULL on failure.
+ */
+static queue_t *bidir_path(const bidir_t *st)
+{
+	queue_t *path = vertex_path(st->meet, st->link[0]);
+	vertex_t const *curr;
+	char *content_copy;
+
+	if (!path)
+		return (NULL);
+	for (curr = st->link[1][st->meet->index]; curr;
+		 curr = st->link[1][curr->index])
+	{
+		content_copy = strdup(curr->content);
+		if (!content_copy || !queue_push_back(path, content_copy))
+		{
+			free(content_copy);
+			queue_delete(path);
+			return (NULL);
+		}
+	}
+	return (path);
+}
+
+/**
+ * bidirectional_dijkstra_graph - Searches for the shortest path from a
+ * start to a target vertex in a graph, growing Dijkstra searches from
+ * both ends at once: two balls of half the radius settle far fewer
+ * vertices than one ball around the start.
+ * The backward search follows the incoming edges of the vertices: their
+ * in_edges lists if the graph tracks them (see graph_track_in_edges),
+ * which callers running many queries should enable once, or else a copy
+ * built for the query, in time linear in the size of the graph.
+ * @graph: Pointer to the graph to go through.
+ * @start: Pointer to the starting vertex.
+ * @target: Pointer to the target vertex.
+ *
+ * Return: A queue with the shortest path, or NULL on failure.
+ */
+queue_t *bidirectional_dijkstra_graph(const graph_t *graph,
+									  vertex_t const *start,
+									  vertex_t const *target)
+{
+	bidir_t st;
+	size_t nb_v, i;
+	queue_t *path = NULL;
+
+	if (!graph || !start || !target)
+		return (NULL);
+	nb_v = graph->nb_slots;
+	memset(&st, 0, sizeof(st));
+	for (i = 0; i < 2; i++)
+	{
+		st.dist[i] = malloc(sizeof(*st.dist[i]) * nb_v);
+		st.link[i] = calloc(nb_v, sizeof(*st.link[i]));
+		st.heap[i] = st.dist[i] ? min_heap_create(nb_v, st.dist[i]) : NULL;
+	}
+	st.verts = malloc(sizeof(*st.verts) * nb_v);
+	if (st.dist[0] && st.dist[1] && st.link[0] && st.link[1] &&
+		st.heap[0] && st.heap[1] && st.verts &&
+		(graph->track_in_edges || bidir_reverse(&st, graph)))
+	{
+		for (i = 0; i < nb_v; i++)
+			st.dist[0][i] = st.dist[1][i] = INT_MAX;
+		PATH_TRACE_BEGIN(st.trace, "bidirectional_dijkstra_graph");
+		bidir_search(&st, start, target);
+		PATH_TRACE_END(st.trace);
+		if (st.meet)
+			path = bidir_path(&st);
+	}
+	for (i = 0; i < 2; i++)
+		free(st.dist[i]), free(st.link[i]), min_heap_delete(st.heap[i]);
+	free(st.verts), free(st.in), free(st.in_nodes);
+	return (path);
+}
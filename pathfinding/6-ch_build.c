@@ -0,0 +1,136 @@
+#include "pathfinding.h"
+#include <string.h>
+
+/**
+ * ch_priority - Computes the contraction priority of a node: the number
+ * of shortcuts its contraction adds minus the number of arcs it removes
+ * (edge difference), plus the number of its neighbours already contracted
+ * to spread the contractions evenly over the graph.
+ * @work: Pointer to the graph being contracted.
+ * @node: The node.
+ *
+ * Return: The priority, lowest to contract first.
+ */
+static int ch_priority(ch_work_t *work, size_t node)
+{
+	return (ch_contract(work, node, 1) - (int)work->in[node].len -
+			(int)work->out[node].len + (int)work->deleted[node]);
+}
+
+/**
+ * ch_contract_all - Contracts every node, lowest priority first. The
+ * priorities are updated lazily: the node taken out of the queue is
+ * contracted only if its current priority is still the lowest. Nodes
+ * are ranked in the order they are contracted.
+ * @work: Pointer to the graph being contracted.
+ *
+ * Return: 1 on success, 0 on failure.
+ */
+static int ch_contract_all(ch_work_t *work)
+{
+	size_t node, rank = 0;
+	int prio;
+
+	for (node = 0; node < work->nb_nodes; node++)
+	{
+		work->prio[node] = ch_priority(work, node);
+		min_heap_push(work->order, node);
+	}
+	while ((node = min_heap_pop(work->order)) != MIN_HEAP_NONE)
+	{
+		prio = ch_priority(work, node);
+		if (work->order->size > 0 &&
+			prio > work->prio[work->order->nodes[0]])
+		{
+			work->prio[node] = prio;
+			min_heap_push(work->order, node);
+			continue;
+		}
+		work->rank[node] = rank++;
+		if (ch_contract(work, node, 0) < 0)
+			return (0);
+		ch_work_remove(work, node);
+	}
+	return (1);
+}
+
+/**
+ * ch_collect - Copies the arcs of a contracted graph into a hierarchy.
+ * Arcs are copied field by field, leaving the zeroed padding of the
+ * hierarchy's arcs untouched (see ch_alloc).
+ * @ch: Pointer to the hierarchy, sized for the arcs.
+ * @work: Pointer to the contracted graph.
+ */
+static void ch_collect(ch_t *ch, const ch_work_t *work)
+{
+	const ch_adj_t *adj;
+	ch_arc_t *arc;
+	size_t node, k, side;
+
+	ch->up_first[0] = ch->down_first[0] = 0;
+	for (node = 0; node < work->nb_nodes; node++)
+		for (side = 0; side < 2; side++)
+		{
+			adj = side ? &work->in[node] : &work->out[node];
+			arc = side ? ch->down + ch->down_first[node] :
+				ch->up + ch->up_first[node];
+			for (k = 0; k < adj->len; k++)
+			{
+				arc[k].node = adj->arcs[k].node;
+				arc[k].middle = adj->arcs[k].middle;
+				arc[k].weight = adj->arcs[k].weight;
+			}
+			if (side)
+				ch->down_first[node + 1] = ch->down_first[node] + adj->len;
+			else
+				ch->up_first[node + 1] = ch->up_first[node] + adj->len;
+		}
+}
+
+/**
+ * ch_build - Preprocesses a graph into a contraction hierarchy: vertices
+ * are contracted one after the other, bypassed by shortcut arcs where
+ * they lie on a shortest path. A query then only follows arcs to higher
+ * nodes from both ends (see ch_query), which settles a tiny part of the
+ * graph. Preprocessing takes long on big graphs, but is done once and
+ * can be saved (see ch_save).
+ * Edge weights must not be negative.
+ * @graph: Pointer to the graph. It must outlive the hierarchy, and not
+ * change while the hierarchy is in use.
+ *
+ * Return: A pointer to the hierarchy, or NULL on failure.
+ */
+ch_t *ch_build(const graph_t *graph)
+{
+	size_t *node_of, nb_up = 0, nb_down = 0, n = 0, i;
+	const vertex_t *v;
+	ch_work_t *work = NULL;
+	ch_t *ch = NULL;
+
+	if (!graph)
+		return (NULL);
+	node_of = malloc(sizeof(*node_of) * (graph->nb_slots + 1));
+	if (node_of)
+		for (v = graph->vertices; v; v = v->next)
+			node_of[v->index] = n++;
+	work = node_of ? ch_work_create(graph, node_of, n) : NULL;
+	if (work && ch_contract_all(work))
+	{
+		for (i = 0; i < n; i++)
+			nb_up += work->out[i].len, nb_down += work->in[i].len;
+		ch = ch_alloc(n, nb_up, nb_down, graph->nb_slots);
+	}
+	if (ch)
+	{
+		ch_collect(ch, work);
+		memcpy(ch->rank, work->rank, sizeof(*ch->rank) * n);
+		for (v = graph->vertices; v; v = v->next)
+		{
+			ch->node_of[v->index] = node_of[v->index];
+			ch->verts[node_of[v->index]] = v;
+		}
+	}
+	ch_work_delete(work);
+	free(node_of);
+	return (ch);
+}
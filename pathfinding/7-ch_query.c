@@ -0,0 +1,207 @@
+#include "pathfinding.h"
+#include <limits.h>
+#include <string.h>
+
+/**
+ * ch_settle - Settles the closest node of one side of a query, and
+ * relaxes its arcs to higher nodes (forward) or from higher nodes
+ * (backward), recording the shortest path through each arc leading to a
+ * node the other side reached.
+ * @ch: Pointer to the hierarchy.
+ * @ctx: Pointer to the query scratch.
+ * @side: 0 for the forward search, 1 for the backward search.
+ * @from: The vertex the side started from, for the trace.
+ */
+static void ch_settle(const ch_t *ch, ch_query_ctx_t *ctx, int side,
+					  vertex_t const *from)
+{
+	size_t u = min_heap_pop(ctx->heap[side]), k, v;
+	const size_t *first = side ? ch->down_first : ch->up_first;
+	const ch_arc_t *arcs = side ? ch->down : ch->up;
+	int *dist = ctx->dist[side], *other = ctx->dist[!side];
+
+	(void)from; /* Only traced */
+	PATH_TRACE_VERTEX(ctx->trace, ch->verts[u], from, side, dist[u]);
+	for (k = first[u]; k < first[u + 1]; k++)
+	{
+		PATH_TRACE_RELAX(ctx->trace);
+		v = arcs[k].node;
+		if (dist[u] + arcs[k].weight < dist[v])
+		{
+			if (dist[v] == INT_MAX && other[v] == INT_MAX)
+				ctx->touched[ctx->nb_touched++] = v;
+			dist[v] = dist[u] + arcs[k].weight;
+			ctx->parent[side][v] = u;
+			ctx->via[side][v] = &arcs[k];
+			min_heap_push(ctx->heap[side], v);
+		}
+		if (other[v] != INT_MAX && (long)dist[v] + other[v] < ctx->best)
+		{
+			ctx->best = (long)dist[v] + other[v];
+			ctx->meet = v;
+		}
+	}
+}
+
+/**
+ * ch_unpack - Appends to a path the vertices an arc goes through, after
+ * its source, replacing shortcuts by the arcs they stand for. The
+ * bypassed nodes get lower at each level, so the recursion is at most as
+ * deep as the number of nodes, and far less in practice.
+ * @ch: Pointer to the hierarchy.
+ * @from: Source node of the arc.
+ * @to: Target node of the arc.
+ * @middle: Node the arc bypasses, or CH_NONE.
+ * @path: The path.
+ *
+ * Return: 1 on success, 0 on failure.
+ */
+static int ch_unpack(const ch_t *ch, size_t from, size_t to, size_t middle,
+					 queue_t *path)
+{
+	const ch_arc_t *in = NULL, *out = NULL;
+	size_t k;
+	char *content_copy;
+
+	if (middle == CH_NONE)
+	{
+		content_copy = strdup(ch->verts[to]->content);
+		if (content_copy && queue_push_back(path, content_copy))
+			return (1);
+		free(content_copy);
+		return (0);
+	}
+	/* The bypassed node is lower than both ends: it holds both arcs */
+	for (k = ch->down_first[middle]; k < ch->down_first[middle + 1]; k++)
+		if (ch->down[k].node == from)
+			in = &ch->down[k];
+	for (k = ch->up_first[middle]; k < ch->up_first[middle + 1]; k++)
+		if (ch->up[k].node == to)
+			out = &ch->up[k];
+	return (in && out && ch_unpack(ch, from, middle, in->middle, path) &&
+			ch_unpack(ch, middle, to, out->middle, path));
+}
+
+/**
+ * ch_path - Builds the path found by a query: up the forward search from
+ * the start to the meeting node, then down the backward search to the
+ * target, unpacking the shortcuts.
+ * @ch: Pointer to the hierarchy.
+ * @ctx: Pointer to the query scratch.
+ * @start: Node of the starting vertex.
+ * @target: Node of the target vertex.
+ *
+ * Return: A queue with the path, or NULL on failure.
+ */
+static queue_t *ch_path(const ch_t *ch, const ch_query_ctx_t *ctx,
+						size_t start, size_t target)
+{
+	queue_t *path = queue_create();
+	size_t *chain, len = 0, i, x;
+	int ok;
+
+	for (x = ctx->meet; x != start; x = ctx->parent[0][x])
+		len++;
+	chain = malloc(sizeof(*chain) * (len + 1));
+	ok = path && chain && ch_unpack(ch, start, start, CH_NONE, path);
+	for (i = len, x = ctx->meet; ok && x != start; x = ctx->parent[0][x])
+		chain[--i] = x;
+	for (i = 0; ok && i < len; i++)
+		ok = ch_unpack(ch, ctx->parent[0][chain[i]], chain[i],
+					   ctx->via[0][chain[i]]->middle, path);
+	for (x = ctx->meet; ok && x != target; x = ctx->parent[1][x])
+		ok = ch_unpack(ch, x, ctx->parent[1][x], ctx->via[1][x]->middle,
+					   path);
+	free(chain);
+	if (!ok)
+		queue_delete(path), path = NULL;
+	return (path);
+}
+
+/**
+ * ch_search - Runs a query: a Dijkstra search up the hierarchy from each
+ * end, until no shorter path can be found. Only the nodes reached are
+ * reset afterwards, so a query costs nothing in the size of the graph.
+ * @ch: Pointer to the hierarchy.
+ * @ctx: Pointer to the query scratch, reset.
+ * @start: Pointer to the starting vertex.
+ * @s: Node of the starting vertex.
+ * @target: Pointer to the target vertex.
+ * @t: Node of the target vertex.
+ *
+ * Return: A queue with the shortest path, or NULL on failure.
+ */
+static queue_t *ch_search(const ch_t *ch, ch_query_ctx_t *ctx,
+						  vertex_t const *start, size_t s,
+						  vertex_t const *target, size_t t)
+{
+	queue_t *path = NULL;
+	long top[2];
+	size_t i;
+	int side;
+
+	ctx->dist[0][s] = ctx->dist[1][t] = 0;
+	ctx->touched[0] = s, ctx->touched[1] = t, ctx->nb_touched = 2;
+	min_heap_push(ctx->heap[0], s), min_heap_push(ctx->heap[1], t);
+	ctx->best = s == t ? 0 : INT_MAX;
+	ctx->meet = s == t ? s : CH_NONE;
+	PATH_TRACE_BEGIN(ctx->trace, "ch_query");
+	while (1)
+	{
+		for (side = 0; side < 2; side++)
+			top[side] = ctx->heap[side]->size ?
+				ctx->dist[side][ctx->heap[side]->nodes[0]] : INT_MAX;
+		if (top[0] >= ctx->best && top[1] >= ctx->best)
+			break;
+		side = top[1] < top[0];
+		ch_settle(ch, ctx, side, side ? target : start);
+	}
+	PATH_TRACE_END(ctx->trace);
+	if (ctx->meet != CH_NONE)
+		path = ch_path(ch, ctx, s, t);
+	for (i = 0; i < ctx->nb_touched; i++)
+	{
+		ctx->dist[0][ctx->touched[i]] = INT_MAX;
+		ctx->dist[1][ctx->touched[i]] = INT_MAX;
+	}
+	for (side = 0; side < 2; side++)
+		while (min_heap_pop(ctx->heap[side]) != MIN_HEAP_NONE)
+			;
+	return (path);
+}
+
+/**
+ * ch_query - Searches for the shortest path from a start to a target
+ * vertex with a contraction hierarchy (see ch_search). The hierarchy is
+ * only read, so threads can query it at once, each with its own scratch.
+ * @ch: Pointer to the hierarchy (see ch_build and ch_load).
+ * @ctx: Pointer to the query scratch (see ch_query_ctx_create), or NULL
+ * to allocate one for this query only, which costs time linear in the
+ * number of nodes.
+ * @start: Pointer to the starting vertex.
+ * @target: Pointer to the target vertex.
+ *
+ * Return: A queue with the shortest path, as dijkstra_graph returns it,
+ * or NULL on failure.
+ */
+queue_t *ch_query(const ch_t *ch, ch_query_ctx_t *ctx, vertex_t const *start,
+				  vertex_t const *target)
+{
+	ch_query_ctx_t *own = NULL;
+	size_t s, t;
+	queue_t *path;
+
+	if (!ch || !start || !target || start->index >= ch->nb_slots ||
+		target->index >= ch->nb_slots)
+		return (NULL);
+	s = ch->node_of[start->index], t = ch->node_of[target->index];
+	if (s == CH_NONE || t == CH_NONE)
+		return (NULL);
+	if (!ctx)
+		ctx = own = ch_query_ctx_create(ch);
+	if (!ctx || ctx->nb_nodes != ch->nb_nodes)
+		return (NULL);
+	path = ch_search(ch, ctx, start, s, target, t);
+	ch_query_ctx_delete(own);
+	return (path);
+}
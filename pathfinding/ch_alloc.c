@@ -0,0 +1,114 @@
+#include "pathfinding.h"
+#include <limits.h>
+
+/**
+ * ch_alloc - Allocates a contraction hierarchy.
+ * @nb_nodes: Number of nodes.
+ * @nb_up: Number of arcs to higher nodes.
+ * @nb_down: Number of arcs from higher nodes.
+ * @nb_slots: Number of vertex indices of the graph.
+ *
+ * Return: A pointer to the hierarchy, whose arcs, ranks and vertices are
+ * left to fill and whose node_of entries are CH_NONE, or NULL on failure.
+ * The arcs are zeroed, padding included, so that ch_save writes no stale
+ * bytes.
+ */
+ch_t *ch_alloc(size_t nb_nodes, size_t nb_up, size_t nb_down,
+			   size_t nb_slots)
+{
+	ch_t *ch = calloc(1, sizeof(*ch));
+	size_t i;
+
+	if (!ch)
+		return (NULL);
+	ch->nb_nodes = nb_nodes, ch->nb_slots = nb_slots;
+	ch->up_first = malloc(sizeof(*ch->up_first) * (nb_nodes + 1));
+	ch->up = calloc(nb_up + 1, sizeof(*ch->up));
+	ch->down_first = malloc(sizeof(*ch->down_first) * (nb_nodes + 1));
+	ch->down = calloc(nb_down + 1, sizeof(*ch->down));
+	ch->rank = malloc(sizeof(*ch->rank) * (nb_nodes + 1));
+	ch->verts = malloc(sizeof(*ch->verts) * (nb_nodes + 1));
+	ch->node_of = malloc(sizeof(*ch->node_of) * (nb_slots + 1));
+	if (!ch->up_first || !ch->up || !ch->down_first || !ch->down ||
+		!ch->rank || !ch->verts || !ch->node_of)
+	{
+		ch_delete(ch);
+		return (NULL);
+	}
+	for (i = 0; i < nb_slots; i++)
+		ch->node_of[i] = CH_NONE;
+	return (ch);
+}
+
+/**
+ * ch_delete - Deletes a contraction hierarchy.
+ * @ch: Pointer to the hierarchy.
+ */
+void ch_delete(ch_t *ch)
+{
+	if (!ch)
+		return;
+	free(ch->up_first), free(ch->up);
+	free(ch->down_first), free(ch->down), free(ch->rank);
+	free(ch->verts), free(ch->node_of);
+	free(ch);
+}
+
+/**
+ * ch_query_ctx_create - Allocates the scratch of the queries of a
+ * contraction hierarchy. It can be reused for any number of queries, one
+ * at a time, on the hierarchies of the same number of nodes.
+ * @ch: Pointer to the hierarchy.
+ *
+ * Return: A pointer to the scratch, or NULL on failure.
+ */
+ch_query_ctx_t *ch_query_ctx_create(const ch_t *ch)
+{
+	ch_query_ctx_t *ctx;
+	size_t n, i, j;
+	int ok;
+
+	ctx = ch ? calloc(1, sizeof(*ctx)) : NULL;
+	if (!ctx)
+		return (NULL);
+	n = ctx->nb_nodes = ch->nb_nodes;
+	ctx->touched = malloc(sizeof(*ctx->touched) * (2 * n + 1));
+	ok = ctx->touched != NULL;
+	for (i = 0; i < 2; i++)
+	{
+		ctx->dist[i] = malloc(sizeof(*ctx->dist[i]) * (n + 1));
+		for (j = 0; ctx->dist[i] && j < n; j++)
+			ctx->dist[i][j] = INT_MAX;
+		ctx->parent[i] = malloc(sizeof(*ctx->parent[i]) * (n + 1));
+		ctx->via[i] = malloc(sizeof(*ctx->via[i]) * (n + 1));
+		ctx->heap[i] = ctx->dist[i] ? min_heap_create(n, ctx->dist[i]) : NULL;
+		ok = ok && ctx->dist[i] && ctx->parent[i] && ctx->via[i] &&
+			ctx->heap[i];
+	}
+	if (!ok)
+	{
+		ch_query_ctx_delete(ctx);
+		return (NULL);
+	}
+	return (ctx);
+}
+
+/**
+ * ch_query_ctx_delete - Deletes the scratch of the queries of a
+ * contraction hierarchy.
+ * @ctx: Pointer to the scratch.
+ */
+void ch_query_ctx_delete(ch_query_ctx_t *ctx)
+{
+	size_t i;
+
+	if (!ctx)
+		return;
+	for (i = 0; i < 2; i++)
+	{
+		free(ctx->dist[i]), free(ctx->parent[i]), free(ctx->via[i]);
+		min_heap_delete(ctx->heap[i]);
+	}
+	free(ctx->touched);
+	free(ctx);
+}
@@ -0,0 +1,96 @@
+#include "pathfinding.h"
+#include <limits.h>
+
+/* Nodes a witness search settles at most before giving up */
+#define CH_WITNESS_SETTLED 128
+/* The same, when only counting the shortcuts to rank the nodes */
+#define CH_SIMULATE_SETTLED 32
+
+/**
+ * witness_search - Looks for the shortest paths from a node to its
+ * neighbours that avoid a node, with a Dijkstra search among the nodes
+ * not contracted yet. The search is local: it stops past a distance, or
+ * after a number of nodes, in which case a shortcut may be added that a
+ * longer search would have spared, which costs space, not correctness.
+ * @work: Pointer to the graph being contracted; its dist receives the
+ * distances found, INT_MAX for the nodes not reached.
+ * @from: The node to start from.
+ * @skip: The node to avoid.
+ * @limit: Distance past which paths are of no use.
+ * @max_settled: Number of nodes to settle at most.
+ */
+static void witness_search(ch_work_t *work, size_t from, size_t skip,
+						   int limit, size_t max_settled)
+{
+	size_t u, i, w, settled = 0;
+	const ch_adj_t *out;
+	int d;
+
+	for (i = 0; i < work->nb_touched; i++)
+		work->dist[work->touched[i]] = INT_MAX;
+	while (min_heap_pop(work->heap) != MIN_HEAP_NONE)
+		;
+	work->dist[from] = 0;
+	work->touched[0] = from;
+	work->nb_touched = 1;
+	min_heap_push(work->heap, from);
+	while ((u = min_heap_pop(work->heap)) != MIN_HEAP_NONE)
+	{
+		if (work->dist[u] > limit || ++settled > max_settled)
+			break;
+		for (out = &work->out[u], i = 0; i < out->len; i++)
+		{
+			w = out->arcs[i].node;
+			d = work->dist[u] + out->arcs[i].weight;
+			if (w == skip || d >= work->dist[w])
+				continue;
+			if (work->dist[w] == INT_MAX)
+				work->touched[work->nb_touched++] = w;
+			work->dist[w] = d;
+			min_heap_push(work->heap, w);
+		}
+	}
+}
+
+/**
+ * ch_contract - Contracts a node: for each pair of a neighbour it comes
+ * from and a neighbour it leads to, adds a shortcut between them, unless
+ * a path as short avoids the node.
+ * @work: Pointer to the graph being contracted.
+ * @node: The node.
+ * @simulate: 1 to only count the shortcuts, without adding them.
+ *
+ * Return: The number of shortcuts, or -1 on failure.
+ */
+int ch_contract(ch_work_t *work, size_t node, int simulate)
+{
+	const ch_adj_t *in = &work->in[node], *out = &work->out[node];
+	size_t i, j, u, w;
+	int count = 0, limit, d;
+
+	for (i = 0; i < in->len; i++)
+	{
+		u = in->arcs[i].node;
+		for (limit = -1, j = 0; j < out->len; j++)
+			if (out->arcs[j].node != u &&
+				in->arcs[i].weight + out->arcs[j].weight > limit)
+				limit = in->arcs[i].weight + out->arcs[j].weight;
+		if (limit < 0)
+			continue;
+		witness_search(work, u, node, limit, simulate ?
+					   CH_SIMULATE_SETTLED : CH_WITNESS_SETTLED);
+		for (j = 0; j < out->len; j++)
+		{
+			w = out->arcs[j].node;
+			d = in->arcs[i].weight + out->arcs[j].weight;
+			if (w == u || work->dist[w] <= d)
+				continue;
+			count++;
+			if (!simulate &&
+				(!ch_adj_set(&work->out[u], w, d, node) ||
+				 !ch_adj_set(&work->in[w], u, d, node)))
+				return (-1);
+		}
+	}
+	return (count);
+}
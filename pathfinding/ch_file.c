@@ -0,0 +1,200 @@
+#include "pathfinding.h"
+#include <string.h>
+#include <sys/stat.h>
+
+/**
+ * ch_save - Saves a contraction hierarchy to a file, to be loaded back
+ * with ch_load by the hosts of the same architecture, in place of the
+ * preprocessing.
+ * @ch: Pointer to the hierarchy.
+ * @path: Path of the file to write.
+ *
+ * Return: 1 on success, 0 on failure.
+ */
+int ch_save(const ch_t *ch, const char *path)
+{
+	ch_file_t hdr;
+	FILE *file;
+	size_t i;
+	int ok;
+
+	if (!ch || !path)
+		return (0);
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, CH_FILE_MAGIC, sizeof(hdr.magic));
+	hdr.version = CH_FILE_VERSION;
+	hdr.byte_order = 0x01020304;
+	hdr.word_size = sizeof(void *);
+	hdr.nb_nodes = ch->nb_nodes;
+	hdr.nb_up = ch->up_first[ch->nb_nodes];
+	hdr.nb_down = ch->down_first[ch->nb_nodes];
+	for (i = 0; i < ch->nb_nodes; i++)
+		hdr.strings_size += strlen(ch->verts[i]->content) + 1;
+	file = fopen(path, "wb");
+	if (!file)
+		return (0);
+	ok = fwrite(&hdr, sizeof(hdr), 1, file) == 1 &&
+		fwrite(ch->up_first, sizeof(size_t), ch->nb_nodes + 1, file) ==
+		ch->nb_nodes + 1 &&
+		fwrite(ch->up, sizeof(ch_arc_t), hdr.nb_up, file) == hdr.nb_up &&
+		fwrite(ch->down_first, sizeof(size_t), ch->nb_nodes + 1, file) ==
+		ch->nb_nodes + 1 &&
+		fwrite(ch->down, sizeof(ch_arc_t), hdr.nb_down, file) == hdr.nb_down &&
+		fwrite(ch->rank, sizeof(size_t), ch->nb_nodes, file) == ch->nb_nodes;
+	for (i = 0; ok && i < ch->nb_nodes; i++)
+		ok = fputs(ch->verts[i]->content, file) >= 0 &&
+			fputc('\0', file) != EOF;
+	return (fclose(file) == 0 && ok);
+}
+
+/**
+ * file_fits - Checks that a hierarchy file is exactly as long as its
+ * header says, so that no count read from it sizes an allocation or a
+ * read past what the file holds. Each part is taken off the bytes left
+ * after checking that it fits, which cannot overflow.
+ * @hdr: Header read from the file.
+ * @file: The file.
+ *
+ * Return: 1 if it does, 0 otherwise.
+ */
+static int file_fits(const ch_file_t *hdr, FILE *file)
+{
+	uint64_t counts[6], sizes[6], left;
+	struct stat st;
+	size_t i;
+
+	counts[0] = counts[2] = hdr->nb_nodes + 1;
+	sizes[0] = sizes[2] = sizeof(size_t);
+	counts[1] = hdr->nb_up, counts[3] = hdr->nb_down;
+	sizes[1] = sizes[3] = sizeof(ch_arc_t);
+	counts[4] = hdr->nb_nodes, sizes[4] = sizeof(size_t);
+	counts[5] = hdr->strings_size, sizes[5] = 1;
+	if (fstat(fileno(file), &st) != 0 || st.st_size < (off_t)sizeof(*hdr))
+		return (0);
+	left = (uint64_t)st.st_size - sizeof(*hdr);
+	if (hdr->nb_nodes >= left) /* Also keeps nb_nodes + 1 from wrapping */
+		return (0);
+	for (i = 0; i < 6; i++)
+	{
+		if (counts[i] > left / sizes[i])
+			return (0);
+		left -= counts[i] * sizes[i];
+	}
+	return (left == 0);
+}
+
+/**
+ * check_arcs - Checks that the arcs read from a file are consistent and
+ * follow the ranks of the nodes: every arc leads to a higher node, and
+ * every shortcut bypasses a node lower than both its ends. Queries then
+ * stay within bounds whatever the file holds, and unpacking a shortcut
+ * goes down the ranks, so it ends.
+ * @first: Per node, first of its arcs (nb_nodes + 1 entries).
+ * @arcs: The arcs.
+ * @rank: Per node, its rank (only ever compared).
+ * @nb_nodes: Number of nodes.
+ * @nb_arcs: Number of arcs.
+ *
+ * Return: 1 if they are, 0 otherwise.
+ */
+static int check_arcs(const size_t *first, const ch_arc_t *arcs,
+					  const size_t *rank, size_t nb_nodes, size_t nb_arcs)
+{
+	size_t i, k;
+
+	if (first[0] != 0 || first[nb_nodes] != nb_arcs)
+		return (0);
+	for (i = 0; i < nb_nodes; i++)
+		if (first[i] > first[i + 1])
+			return (0);
+	for (i = 0; i < nb_nodes; i++)
+		for (k = first[i]; k < first[i + 1]; k++)
+		{
+			if (arcs[k].node >= nb_nodes || rank[arcs[k].node] <= rank[i])
+				return (0);
+			if (arcs[k].middle != CH_NONE && (arcs[k].middle >= nb_nodes ||
+											  rank[arcs[k].middle] >= rank[i]))
+				return (0);
+		}
+	return (1);
+}
+
+/**
+ * bind_names - Finds the vertex of each node of a hierarchy in a graph,
+ * by the content strings read from a file.
+ * @ch: Pointer to the hierarchy.
+ * @graph: Pointer to the graph.
+ * @strings: The content strings of the nodes, in node order.
+ * @size: Size of @strings in bytes.
+ *
+ * Return: 1 on success, 0 if a vertex is missing.
+ */
+static int bind_names(ch_t *ch, const graph_t *graph, const char *strings,
+					  size_t size)
+{
+	const vertex_t *v;
+	size_t node, len;
+
+	if (size == 0 || strings[size - 1] != '\0')
+		return (ch->nb_nodes == 0);
+	for (node = 0; node < ch->nb_nodes; node++)
+	{
+		len = size ? strlen(strings) + 1 : 0;
+		v = len ? graph_find_vertex(graph, strings) : NULL;
+		if (!v || ch->node_of[v->index] != CH_NONE)
+			return (0);
+		ch->verts[node] = v;
+		ch->node_of[v->index] = node;
+		strings += len, size -= len;
+	}
+	return (1);
+}
+
+/**
+ * ch_load - Loads a contraction hierarchy saved by ch_save, for the graph
+ * it was built from. Its vertices are found by content, so the graph may
+ * have been rebuilt or loaded from an image since.
+ * @path: Path of the file to read.
+ * @graph: Pointer to the graph. It must outlive the hierarchy, and not
+ * change while the hierarchy is in use.
+ *
+ * Return: A pointer to the hierarchy, or NULL on failure.
+ */
+ch_t *ch_load(const char *path, const graph_t *graph)
+{
+	ch_file_t hdr;
+	FILE *file;
+	ch_t *ch = NULL;
+	char *strings = NULL;
+	int ok;
+
+	file = path && graph ? fopen(path, "rb") : NULL;
+	if (!file)
+		return (NULL);
+	ok = fread(&hdr, sizeof(hdr), 1, file) == 1 &&
+		memcmp(hdr.magic, CH_FILE_MAGIC, sizeof(hdr.magic)) == 0 &&
+		hdr.version == CH_FILE_VERSION && hdr.byte_order == 0x01020304 &&
+		hdr.word_size == sizeof(void *) &&
+		hdr.nb_nodes <= graph->nb_vertices && file_fits(&hdr, file);
+	if (ok)
+		ch = ch_alloc(hdr.nb_nodes, hdr.nb_up, hdr.nb_down, graph->nb_slots);
+	strings = ch ? malloc(hdr.strings_size + 1) : NULL;
+	ok = strings &&
+		fread(ch->up_first, sizeof(size_t), hdr.nb_nodes + 1, file) ==
+		hdr.nb_nodes + 1 &&
+		fread(ch->up, sizeof(ch_arc_t), hdr.nb_up, file) == hdr.nb_up &&
+		fread(ch->down_first, sizeof(size_t), hdr.nb_nodes + 1, file) ==
+		hdr.nb_nodes + 1 &&
+		fread(ch->down, sizeof(ch_arc_t), hdr.nb_down, file) == hdr.nb_down &&
+		fread(ch->rank, sizeof(size_t), hdr.nb_nodes, file) == hdr.nb_nodes &&
+		fread(strings, 1, hdr.strings_size, file) == hdr.strings_size &&
+		check_arcs(ch->up_first, ch->up, ch->rank, hdr.nb_nodes, hdr.nb_up) &&
+		check_arcs(ch->down_first, ch->down, ch->rank, hdr.nb_nodes,
+				   hdr.nb_down) &&
+		bind_names(ch, graph, strings, hdr.strings_size);
+	fclose(file);
+	free(strings);
+	if (!ok)
+		ch_delete(ch), ch = NULL;
+	return (ch);
+}
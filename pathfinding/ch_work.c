@@ -0,0 +1,148 @@
+#include "pathfinding.h"
+#include <limits.h>
+
+/**
+ * ch_adj_set - Adds an arc to a list, or lowers the weight of the arc to
+ * the same node if it is heavier.
+ * @adj: Pointer to the list.
+ * @node: The node at the other end of the arc.
+ * @weight: Weight of the arc.
+ * @middle: Node the arc bypasses, or CH_NONE.
+ *
+ * Return: 1 on success, 0 on failure.
+ */
+int ch_adj_set(ch_adj_t *adj, size_t node, int weight, size_t middle)
+{
+	ch_arc_t *arcs;
+	size_t i;
+
+	for (i = 0; i < adj->len; i++)
+		if (adj->arcs[i].node == node)
+		{
+			if (weight < adj->arcs[i].weight)
+				adj->arcs[i].weight = weight, adj->arcs[i].middle = middle;
+			return (1);
+		}
+	if (adj->len == adj->size)
+	{
+		arcs = realloc(adj->arcs, sizeof(*arcs) * (adj->size ? adj->size * 2 : 4));
+		if (!arcs)
+			return (0);
+		adj->arcs = arcs;
+		adj->size = adj->size ? adj->size * 2 : 4;
+	}
+	adj->arcs[adj->len].node = node;
+	adj->arcs[adj->len].middle = middle;
+	adj->arcs[adj->len++].weight = weight;
+	return (1);
+}
+
+/**
+ * adj_remove - Removes the arc to a node from a list.
+ * @adj: Pointer to the list.
+ * @node: The node.
+ */
+static void adj_remove(ch_adj_t *adj, size_t node)
+{
+	size_t i;
+
+	for (i = 0; i < adj->len; i++)
+		if (adj->arcs[i].node == node)
+		{
+			adj->arcs[i] = adj->arcs[--adj->len];
+			return;
+		}
+}
+
+/**
+ * ch_work_remove - Takes a contracted node out of the lists of its
+ * neighbours, its own lists becoming its arcs to and from higher nodes.
+ * @work: Pointer to the graph being contracted.
+ * @node: The node.
+ */
+void ch_work_remove(ch_work_t *work, size_t node)
+{
+	size_t i, other;
+
+	for (i = 0; i < work->out[node].len; i++)
+	{
+		other = work->out[node].arcs[i].node;
+		adj_remove(&work->in[other], node);
+		work->deleted[other]++;
+	}
+	for (i = 0; i < work->in[node].len; i++)
+	{
+		other = work->in[node].arcs[i].node;
+		adj_remove(&work->out[other], node);
+		work->deleted[other]++;
+	}
+}
+
+/**
+ * ch_work_create - Loads a graph to contract it.
+ * @graph: Pointer to the graph.
+ * @node_of: Node of each vertex index of @graph.
+ * @nb_nodes: Number of nodes.
+ *
+ * Return: A pointer to the graph to contract, or NULL on failure.
+ */
+ch_work_t *ch_work_create(const graph_t *graph, const size_t *node_of,
+						  size_t nb_nodes)
+{
+	ch_work_t *work = calloc(1, sizeof(*work));
+	const vertex_t *v;
+	const edge_t *e;
+	size_t i, u, w;
+	int ok;
+
+	if (!work)
+		return (NULL);
+	work->nb_nodes = nb_nodes;
+	work->out = calloc(nb_nodes + 1, sizeof(*work->out));
+	work->in = calloc(nb_nodes + 1, sizeof(*work->in));
+	work->deleted = calloc(nb_nodes + 1, sizeof(*work->deleted));
+	work->prio = malloc(sizeof(*work->prio) * (nb_nodes + 1));
+	work->rank = malloc(sizeof(*work->rank) * (nb_nodes + 1));
+	work->dist = malloc(sizeof(*work->dist) * (nb_nodes + 1));
+	work->touched = malloc(sizeof(*work->touched) * (nb_nodes + 1));
+	for (i = 0; work->prio && work->dist && i < nb_nodes; i++)
+		work->prio[i] = work->dist[i] = INT_MAX;
+	work->order = work->prio ? min_heap_create(nb_nodes, work->prio) : NULL;
+	work->heap = work->dist ? min_heap_create(nb_nodes, work->dist) : NULL;
+	ok = work->out && work->in && work->deleted && work->rank &&
+		work->touched && work->order && work->heap;
+	for (v = graph->vertices; ok && v; v = v->next)
+		for (e = v->edges; ok && e; e = e->next)
+		{
+			u = node_of[v->index], w = node_of[e->dest->index];
+			if (u != w)
+				ok = ch_adj_set(&work->out[u], w, e->weight, CH_NONE) &&
+					ch_adj_set(&work->in[w], u, e->weight, CH_NONE);
+		}
+	if (!ok)
+	{
+		ch_work_delete(work);
+		return (NULL);
+	}
+	return (work);
+}
+
+/**
+ * ch_work_delete - Deletes a graph being contracted.
+ * @work: Pointer to the graph.
+ */
+void ch_work_delete(ch_work_t *work)
+{
+	size_t i;
+
+	if (!work)
+		return;
+	for (i = 0; work->out && work->in && i < work->nb_nodes; i++)
+		free(work->out[i].arcs), free(work->in[i].arcs);
+	free(work->out), free(work->in), free(work->deleted);
+	free(work->prio), free(work->rank);
+	free(work->dist), free(work->touched);
+	min_heap_delete(work->order);
+	min_heap_delete(work->heap);
+	free(work);
+}
@@ -0,0 +1,118 @@
+#include "pathfinding.h"
+
+/**
+ * heap_before - Tells whether an id comes out of a heap before another:
+ * by key, then by id, so that equal keys come out in index order.
+ * @heap: Pointer to the heap.
+ * @a: The first id.
+ * @b: The second id.
+ *
+ * Return: 1 if @a comes first, 0 otherwise.
+ */
+static int heap_before(const min_heap_t *heap, size_t a, size_t b)
+{
+	if (heap->keys[a] != heap->keys[b])
+		return (heap->keys[a] < heap->keys[b]);
+	return (a < b);
+}
+
+/**
+ * min_heap_create - Creates an indexed binary min-heap of ids.
+ * @capacity: Ids range from 0 to @capacity - 1.
+ * @keys: Key of each id, read by the heap and owned by the caller. Keys
+ * may only decrease while their id is in the heap, then be pushed again.
+ *
+ * Return: A pointer to the heap, or NULL on failure.
+ */
+min_heap_t *min_heap_create(size_t capacity, const int *keys)
+{
+	min_heap_t *heap = malloc(sizeof(*heap));
+	size_t i;
+
+	if (!heap)
+		return (NULL);
+	heap->nodes = malloc(sizeof(*heap->nodes) * (capacity + 1));
+	heap->pos = malloc(sizeof(*heap->pos) * (capacity + 1));
+	if (!heap->nodes || !heap->pos)
+	{
+		min_heap_delete(heap);
+		return (NULL);
+	}
+	for (i = 0; i < capacity; i++)
+		heap->pos[i] = MIN_HEAP_NONE;
+	heap->size = 0;
+	heap->keys = keys;
+	return (heap);
+}
+
+/**
+ * min_heap_delete - Deletes a heap.
+ * @heap: Pointer to the heap.
+ */
+void min_heap_delete(min_heap_t *heap)
+{
+	if (!heap)
+		return;
+	free(heap->nodes);
+	free(heap->pos);
+	free(heap);
+}
+
+/**
+ * min_heap_push - Inserts an id in a heap, or moves it up if it is
+ * already there and its key decreased.
+ * @heap: Pointer to the heap.
+ * @id: The id.
+ */
+void min_heap_push(min_heap_t *heap, size_t id)
+{
+	size_t i = heap->pos[id], parent;
+
+	if (i == MIN_HEAP_NONE)
+		i = heap->size++;
+	while (i > 0)
+	{
+		parent = (i - 1) / 2;
+		if (!heap_before(heap, id, heap->nodes[parent]))
+			break;
+		heap->nodes[i] = heap->nodes[parent];
+		heap->pos[heap->nodes[i]] = i;
+		i = parent;
+	}
+	heap->nodes[i] = id;
+	heap->pos[id] = i;
+}
+
+/**
+ * min_heap_pop - Takes the id with the smallest key out of a heap.
+ * @heap: Pointer to the heap.
+ *
+ * Return: The id, or MIN_HEAP_NONE if the heap is empty.
+ */
+size_t min_heap_pop(min_heap_t *heap)
+{
+	size_t top, last, i = 0, child;
+
+	if (heap->size == 0)
+		return (MIN_HEAP_NONE);
+	top = heap->nodes[0];
+	heap->pos[top] = MIN_HEAP_NONE;
+	last = heap->nodes[--heap->size];
+	while ((child = 2 * i + 1) < heap->size)
+	{
+		if (child + 1 < heap->size &&
+			heap_before(heap, heap->nodes[child + 1], heap->nodes[child]))
+			child++;
+		if (!heap_before(heap, heap->nodes[child], last))
+			break;
+		heap->nodes[i] = heap->nodes[child];
+		heap->pos[heap->nodes[i]] = i;
+		i = child;
+	}
+	if (heap->size > 0)
+	{
+		heap->nodes[i] = last;
+		heap->pos[last] = i;
+	}
+	return (top);
+}
@@ -0,0 +1,39 @@
+#include "pathfinding.h"
+#include <string.h>
+
+/**
+ * vertex_path - Builds the path leading to a vertex, from the previous
+ * vertex on the path to each vertex, as a queue of vertex names.
+ * @target: Pointer to the last vertex of the path.
+ * @pred: Previous vertex on the path to each vertex index, NULL for the
+ * first vertex of the path.
+ *
+ * Return: A queue with the duplicated names of the vertices, from the
+ * first vertex to @target, or NULL on failure.
+ */
+queue_t *vertex_path(vertex_t const *target, vertex_t const **pred)
+{
+	queue_t *path = queue_create();
+	vertex_t const *curr;
+	char *content_copy;
+
+	if (!path)
+		return (NULL);
+
+	for (curr = target; curr; curr = pred[curr->index])
+	{
+		content_copy = strdup(curr->content);
+		if (!content_copy)
+		{
+			queue_delete(path);
+			return (NULL);
+		}
+		if (!queue_push_front(path, content_copy))
+		{
+			free(content_copy);
+			queue_delete(path);
+			return (NULL);
+		}
+	}
+	return (path);
+}
@@ -0,0 +1,21 @@
+#include "pathfinding.h"
+
+/**
+ * path_trace_print - Trace hook printing each vertex or cell a search
+ * examines: build with -DPATHFINDING_TRACE=path_trace_print.
+ * @trace: The trace of the search.
+ */
+void path_trace_print(const path_trace_t *trace)
+{
+	if (trace->done)
+		return;
+	if (!trace->vertex)
+		printf("Checking coordinates [%d, %d]\n",
+			   trace->cell.x, trace->cell.y);
+	else if (!trace->origin)
+		printf("Checking %s\n", trace->vertex->content);
+	else
+		printf("Checking %s, distance %s %s is %d\n",
+			   trace->vertex->content, trace->backward ? "to" : "from",
+			   trace->origin->content, trace->distance);
+}
@@ -3,6 +3,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
 #include "queues.h"
 #include "graphs.h"
 
@@ -18,6 +19,258 @@ typedef struct point_s
 	int y;
 } point_t;
 
+/**
+ * enum astar_metric_e - Moves allowed in a two-dimensional array, and the
+ * matching heuristic of astar_array
+ *
+ * @ASTAR_MANHATTAN: Moves to the 4 side neighbours, Manhattan distance
+ * @ASTAR_OCTILE: Moves to the 8 neighbours, a diagonal move costing about
+ * sqrt(2) times a side move, octile distance
+ */
+typedef enum astar_metric_e
+{
+	ASTAR_MANHATTAN = 0,
+	ASTAR_OCTILE
+} astar_metric_t;
+
+/* Id returned by an empty heap, and position of an id out of the heap */
+#define MIN_HEAP_NONE ((size_t)-1)
+
+/**
+ * struct min_heap_s - Indexed binary min-heap of ids (vertex indices,
+ * cells, ...), ordered by a key array owned by the caller. Knowing the
+ * position of each id, it can move an id up when its key decreases.
+ *
+ * @nodes: The ids, as a binary heap
+ * @pos: Position of each id in @nodes, or MIN_HEAP_NONE
+ * @size: Number of ids in @nodes
+ * @keys: Key of each id
+ */
+typedef struct min_heap_s
+{
+	size_t *nodes;
+	size_t *pos;
+	size_t size;
+	const int *keys;
+} min_heap_t;
+
+/**
+ * struct path_trace_s - Trace of a search, handed to the trace hook for
+ * each vertex or cell the search examines, then once when it ends
+ *
+ * @search: Name of the search function
+ * @vertex: The vertex examined, or NULL for a cell, or at the end
+ * @origin: The vertex @distance is counted from (or to, if @backward),
+ * NULL for the searches that do not count distances
+ * @backward: 1 if the vertex was reached searching backward from @origin
+ * @distance: Distance of @vertex from (to) @origin
+ * @cell: The cell examined, when @vertex is NULL
+ * @nb_expanded: Number of vertices or cells examined so far
+ * @nb_relaxed: Number of edges or moves followed so far
+ * @done: 1 once the search has ended
+ */
+typedef struct path_trace_s
+{
+	const char *search;
+	vertex_t const *vertex;
+	vertex_t const *origin;
+	int backward;
+	int distance;
+	point_t cell;
+	size_t nb_expanded;
+	size_t nb_relaxed;
+	int done;
+} path_trace_t;
+
+/*
+ * Trace hook of the searches. Build with -DPATHFINDING_TRACE=fn to have
+ * void fn(const path_trace_t *trace) called on every step of a search;
+ * -DPATHFINDING_TRACE=path_trace_print prints the "Checking ..." lines.
+ * Without it, the searches are silent and the hook compiles to nothing.
+ */
+#ifdef PATHFINDING_TRACE
+void PATHFINDING_TRACE(const path_trace_t *trace);
+#define PATH_TRACE_BEGIN(t, name) ((t).search = (name), (t).done = 0, \
+	(t).nb_expanded = 0, (t).nb_relaxed = 0)
+#define PATH_TRACE_VERTEX(t, v, from, back, dist) ((t).vertex = (v), \
+	(t).origin = (from), (t).backward = (back), (t).distance = (dist), \
+	(t).nb_expanded++, PATHFINDING_TRACE(&(t)))
+#define PATH_TRACE_CELL(t, cx, cy) ((t).vertex = NULL, (t).cell.x = (cx), \
+	(t).cell.y = (cy), (t).nb_expanded++, PATHFINDING_TRACE(&(t)))
+#define PATH_TRACE_RELAX(t) ((t).nb_relaxed++)
+#define PATH_TRACE_END(t) ((t).vertex = NULL, (t).done = 1, \
+	PATHFINDING_TRACE(&(t)))
+#else
+#define PATH_TRACE_BEGIN(t, name) ((void)0)
+#define PATH_TRACE_VERTEX(t, v, from, back, dist) ((void)0)
+#define PATH_TRACE_CELL(t, cx, cy) ((void)0)
+#define PATH_TRACE_RELAX(t) ((void)0)
+#define PATH_TRACE_END(t) ((void)0)
+#endif
+
+/* Contraction hierarchy files (see ch_save) */
+#define CH_FILE_MAGIC "GRAPHCH"
+#define CH_FILE_VERSION 2
+
+/* Node, or middle node of an arc, that does not exist */
+#define CH_NONE ((size_t)-1)
+
+/**
+ * struct ch_arc_s - Arc of a contraction hierarchy
+ *
+ * @node: The node at the other end of the arc
+ * @middle: For a shortcut, the node it bypasses: the shortcut stands for
+ * the arcs from its source to @middle and from @middle to its target.
+ * CH_NONE for an edge of the graph
+ * @weight: Weight of the arc
+ */
+typedef struct ch_arc_s
+{
+	size_t node;
+	size_t middle;
+	int weight;
+} ch_arc_t;
+
+/**
+ * struct ch_s - Contraction hierarchy of a graph, for fast shortest path
+ * queries (see ch_build). Nodes are numbered from 0 in the order of the
+ * vertex list, and ranked in the order they were contracted: higher
+ * nodes are the ones of higher rank. The arcs of node i to higher nodes
+ * are up[up_first[i]] to up[up_first[i + 1] - 1], and the arcs from
+ * higher nodes to node i are down[down_first[i]] to
+ * down[down_first[i + 1] - 1], @node being their source. A shortcut's
+ * middle node is lower than both its ends.
+ * The hierarchy points to the vertices of its graph, which must outlive it
+ *
+ * @nb_nodes: Number of nodes
+ * @up_first: Per node, first of its arcs in @up (nb_nodes + 1 entries)
+ * @up: Arcs to higher nodes
+ * @down_first: Per node, first of its arcs in @down (nb_nodes + 1 entries)
+ * @down: Arcs from higher nodes
+ * @rank: Per node, its position in the contraction order
+ * @verts: Vertex of each node
+ * @node_of: Node of each vertex index of the graph, or CH_NONE
+ * @nb_slots: Number of entries of @node_of
+ */
+typedef struct ch_s
+{
+	size_t nb_nodes;
+	size_t *up_first;
+	ch_arc_t *up;
+	size_t *down_first;
+	ch_arc_t *down;
+	size_t *rank;
+	vertex_t const **verts;
+	size_t *node_of;
+	size_t nb_slots;
+} ch_t;
+
+/**
+ * struct ch_query_ctx_s - Scratch of the queries of a contraction
+ * hierarchy (see ch_query_ctx_create). The hierarchy itself is only read
+ * by queries, so threads can share it, each with its own scratch
+ *
+ * @nb_nodes: Number of nodes of the hierarchies it fits
+ * @dist: Per side, distance of each node, INT_MAX if unknown
+ * @parent: Per side, node each node was reached from
+ * @via: Per side, arc each node was reached through
+ * @heap: Per side, nodes to settle, keyed by @dist
+ * @touched: Nodes whose distances are set
+ * @nb_touched: Number of nodes in @touched
+ * @best: Length of the shortest path found so far
+ * @meet: Node where the searches met on that path, or CH_NONE
+ * @trace: Trace of the query
+ */
+typedef struct ch_query_ctx_s
+{
+	size_t nb_nodes;
+	int *dist[2];
+	size_t *parent[2];
+	const ch_arc_t **via[2];
+	min_heap_t *heap[2];
+	size_t *touched;
+	size_t nb_touched;
+	long best;
+	size_t meet;
+	path_trace_t trace;
+} ch_query_ctx_t;
+
+/**
+ * struct ch_file_s - Header of a contraction hierarchy file. It is
+ * followed by up_first, up, down_first, down and rank as they sit in memory,
+ * then by the content strings of the vertices of the nodes, in node
+ * order, each ended by a null byte
+ *
+ * @magic: CH_FILE_MAGIC
+ * @version: CH_FILE_VERSION
+ * @byte_order: 0x01020304, as written by the host that saved the file
+ * @word_size: sizeof(void *) on the host that saved the file
+ * @reserved: Padding, zero
+ * @nb_nodes: Number of nodes
+ * @nb_up: Number of arcs in up
+ * @nb_down: Number of arcs in down
+ * @strings_size: Size of the content strings in bytes
+ */
+typedef struct ch_file_s
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	uint32_t word_size;
+	uint32_t reserved;
+	uint64_t nb_nodes;
+	uint64_t nb_up;
+	uint64_t nb_down;
+	uint64_t strings_size;
+} ch_file_t;
+
+/**
+ * struct ch_adj_s - Growable list of arcs
+ *
+ * @arcs: The arcs
+ * @len: Number of arcs
+ * @size: Number of arcs allocated
+ */
+typedef struct ch_adj_s
+{
+	ch_arc_t *arcs;
+	size_t len;
+	size_t size;
+} ch_adj_t;
+
+/**
+ * struct ch_work_s - Graph being contracted by ch_build. Once a node is
+ * contracted, its lists are left as they are: they hold its arcs to and
+ * from higher nodes
+ *
+ * @nb_nodes: Number of nodes
+ * @out: Per node, arcs to the nodes not contracted yet
+ * @in: Per node, arcs from the nodes not contracted yet (@node being
+ * their source)
+ * @deleted: Per node, number of neighbours contracted so far
+ * @prio: Per node, contraction priority: lowest first
+ * @rank: Per node, position in the contraction order, once contracted
+ * @order: Nodes not contracted yet, keyed by @prio
+ * @dist: Per node, distance found by the last witness search
+ * @heap: Nodes to settle by the witness search, keyed by @dist
+ * @touched: Nodes whose @dist the last witness search set
+ * @nb_touched: Number of nodes in @touched
+ */
+typedef struct ch_work_s
+{
+	size_t nb_nodes;
+	ch_adj_t *out;
+	ch_adj_t *in;
+	size_t *deleted;
+	int *prio;
+	size_t *rank;
+	min_heap_t *order;
+	int *dist;
+	min_heap_t *heap;
+	size_t *touched;
+	size_t nb_touched;
+} ch_work_t;
+
 /* Function Prototypes */
 
 queue_t *backtracking_array(char **map, int rows, int cols,
@@ -29,4 +282,44 @@ queue_t *backtracking_graph(graph_t *graph, vertex_t const *start,
 queue_t *dijkstra_graph(graph_t *graph, vertex_t const *start,
 						vertex_t const *target);
 
+queue_t *bidirectional_dijkstra_graph(const graph_t *graph,
+									  vertex_t const *start,
+									  vertex_t const *target);
+
+queue_t *astar_graph(graph_t *graph, vertex_t const *start,
+					 vertex_t const *target,
+					 int (*heuristic)(vertex_t const *v,
+									  vertex_t const *target, void *arg),
+					 void *arg);
+
+queue_t *astar_array(char **map, int rows, int cols, point_t const *start,
+					 point_t const *target, astar_metric_t metric);
+
+ch_t *ch_build(const graph_t *graph);
+ch_t *ch_alloc(size_t nb_nodes, size_t nb_up, size_t nb_down,
+			   size_t nb_slots);
+void ch_delete(ch_t *ch);
+int ch_save(const ch_t *ch, const char *path);
+ch_t *ch_load(const char *path, const graph_t *graph);
+ch_query_ctx_t *ch_query_ctx_create(const ch_t *ch);
+void ch_query_ctx_delete(ch_query_ctx_t *ctx);
+queue_t *ch_query(const ch_t *ch, ch_query_ctx_t *ctx, vertex_t const *start,
+				  vertex_t const *target);
+
+ch_work_t *ch_work_create(const graph_t *graph, const size_t *node_of,
+						  size_t nb_nodes);
+void ch_work_delete(ch_work_t *work);
+int ch_adj_set(ch_adj_t *adj, size_t node, int weight, size_t middle);
+void ch_work_remove(ch_work_t *work, size_t node);
+int ch_contract(ch_work_t *work, size_t node, int simulate);
+
+void path_trace_print(const path_trace_t *trace);
+
+queue_t *vertex_path(vertex_t const *target, vertex_t const **pred);
+
+min_heap_t *min_heap_create(size_t capacity, const int *keys);
+void min_heap_delete(min_heap_t *heap);
+void min_heap_push(min_heap_t *heap, size_t id);
+size_t min_heap_pop(min_heap_t *heap);
+
 #endif /* PATHFINDING_H */
@@ -0,0 +1,208 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graphs.h"
+
+/*
+ * Checks that graph_mmap_open maps back what graph_save wrote, and that
+ * it rejects truncated and forged images, headers and contents alike,
+ * instead of relocating or handing them out.
+ * Build it with the sources of graphs, -Igraphs and -lpthread, and run it
+ * from a writable directory.
+ */
+
+#define IMG_PATH "test_graph_image.img"
+#define BAD_PATH "test_graph_image_bad.img"
+
+/**
+ * write_file - Writes a buffer to a file.
+ * @path: Path of the file.
+ * @buf: The bytes to write.
+ * @len: Number of bytes.
+ *
+ * Return: 1 on success, 0 on failure.
+ */
+static int write_file(const char *path, const void *buf, size_t len)
+{
+	FILE *file = fopen(path, "wb");
+	int ok;
+
+	if (!file)
+		return (0);
+	ok = fwrite(buf, 1, len, file) == len;
+	return (fclose(file) == 0 && ok);
+}
+
+/**
+ * same_graph - Compares a mapped graph with the graph it was saved from.
+ * @graph: Pointer to the original graph.
+ * @mapped: Pointer to the mapped graph, or NULL.
+ *
+ * Return: 1 if they hold the same vertices and edges in the same order,
+ * 0 otherwise.
+ */
+static int same_graph(const graph_t *graph, const graph_t *mapped)
+{
+	const vertex_t *v, *w;
+	const edge_t *e, *f;
+
+	if (!mapped || mapped->nb_vertices != graph->nb_vertices)
+		return (0);
+	for (v = graph->vertices, w = mapped->vertices; v && w;
+		 v = v->next, w = w->next)
+	{
+		if (strcmp(v->content, w->content) ||
+			graph_find_vertex(mapped, v->content) != w)
+			return (0);
+		for (e = v->edges, f = w->edges; e && f; e = e->next, f = f->next)
+			if (strcmp(e->dest->content, f->dest->content) ||
+				e->weight != f->weight)
+				return (0);
+		if (e || f)
+			return (0);
+	}
+	return (!v && !w);
+}
+
+/**
+ * rejects - Checks that graph_mmap_open refuses an altered image. An
+ * image it accepts anyway is walked, so that ASan reports the ones that
+ * are not harmless.
+ * @buf: The bytes of the image.
+ * @len: Number of bytes.
+ * @at: Offset of a field to overwrite, or 0 for none.
+ * @value: Value to store in that field.
+ *
+ * Return: 1 if the image is refused, 0 otherwise.
+ */
+static int rejects(const unsigned char *buf, size_t len, size_t at,
+				   uint64_t value)
+{
+	unsigned char *copy = malloc(len + 1);
+	graph_t *mapped;
+
+	if (!copy)
+		return (0);
+	memcpy(copy, buf, len);
+	if (at)
+		memcpy(copy + at, &value, sizeof(value));
+	mapped = write_file(BAD_PATH, copy, len) ? graph_mmap_open(BAD_PATH) :
+		NULL;
+	free(copy);
+	if (mapped)
+		graph_csr_delete(graph_freeze(mapped)), same_graph(mapped, mapped);
+	graph_delete(mapped);
+	return (mapped == NULL);
+}
+
+/**
+ * check_forgeries - Opens truncated and forged copies of a valid image.
+ * @buf: The bytes of the valid image, whose slot 0 is unused and slot 1
+ * holds a vertex with edges.
+ * @len: Number of bytes.
+ *
+ * Return: Number of altered images that were not refused.
+ */
+static int check_forgeries(const unsigned char *buf, size_t len)
+{
+	const graph_image_t *img = (const graph_image_t *)buf;
+	size_t cut, field, v1 = img->vertices + sizeof(vertex_t);
+	uint64_t base = img->base;
+	int fails = 0;
+
+	for (cut = 0; cut < len; cut += 1 + len / 97)
+		fails += !rejects(buf, cut, 0, 0);
+	fails += !rejects(buf, len, offsetof(graph_image_t, nb_slots),
+					  (uint64_t)1 << 60);
+	fails += !rejects(buf, len, offsetof(graph_image_t, nb_edges),
+					  img->nb_edges + 1);
+	fails += !rejects(buf, len, offsetof(graph_image_t, vertices), len);
+	fails += !rejects(buf, len, offsetof(graph_image_t, edges), 1);
+	fails += !rejects(buf, len, offsetof(graph_image_t, buckets),
+					  img->buckets + 1);
+	fails += !rejects(buf, len, offsetof(graph_image_t, strings), len + 1);
+	fails += !rejects(buf, len, offsetof(graph_image_t, graph), 0);
+	fails += !rejects(buf, len, img->graph + offsetof(graph_t, nb_buckets),
+					  (uint64_t)1 << 40);
+	fails += !rejects(buf, len, v1 + offsetof(vertex_t, index), 1000000);
+	fails += !rejects(buf, len, img->vertices, 1); /* Unused slot */
+	fails += !rejects(buf, len, v1 + offsetof(vertex_t, content), base);
+	fails += !rejects(buf, len, v1 + offsetof(vertex_t, next),
+					  base + img->vertices + 1);
+	fails += !rejects(buf, len, v1 + offsetof(vertex_t, prev),
+					  base + img->vertices + sizeof(vertex_t));
+	fails += !rejects(buf, len, v1 + offsetof(vertex_t, edges),
+					  base + img->buckets);
+	fails += !rejects(buf, len, v1 + offsetof(vertex_t, nb_edges), 1000);
+	fails += !rejects(buf, len, v1 + offsetof(vertex_t, in_edges),
+					  base + img->edges);
+	fails += !rejects(buf, len, img->edges + offsetof(edge_t, dest),
+					  base + img->vertices);
+	fails += !rejects(buf, len, img->edges + offsetof(edge_t, next),
+					  base + img->edges);
+	fails += !rejects(buf, len, img->graph + offsetof(graph_t, nb_vertices),
+					  img->nb_slots + 1);
+	fails += !rejects(buf, len, img->graph + offsetof(graph_t, vertices_tail),
+					  base + img->vertices + sizeof(vertex_t));
+	fails += !rejects(buf, len, img->graph + offsetof(graph_t, track_in_edges),
+					  1);
+	fails += !rejects(buf, len, img->buckets, base + img->vertices + 8);
+	fails += !rejects(buf, len, len - 8, 0x4141414141414141); /* No NUL */
+	/* Any other forged offset, count or pointer must be refused or harmless */
+	for (field = offsetof(graph_image_t, nb_slots);
+		 field < sizeof(graph_image_t); field += sizeof(uint64_t))
+		for (cut = 1; cut < 64; cut += 9)
+			rejects(buf, len, field, (uint64_t)1 << cut);
+	for (cut = 0; cut < 3000; cut++)
+		rejects(buf, len, 8 + rand() % (len - 16),
+				base + rand() % len + (cut % 2 ? 0 : (uint64_t)rand() << 32));
+	return (fails);
+}
+
+/**
+ * main - Saves a graph with weighted edges and removed vertices, maps it
+ * back twice (the second mapping being relocated), then opens altered
+ * copies of its image, relocated and not.
+ *
+ * Return: EXIT_SUCCESS if every check passes, EXIT_FAILURE otherwise.
+ */
+int main(void)
+{
+	graph_t *graph = graph_create(), *first, *second;
+	char src[16], dest[16];
+	unsigned char *buf = NULL;
+	FILE *file;
+	long len = 0;
+	int fails = 0, i;
+
+	srand(7);
+	for (i = 0; graph && i < 60; i++)
+		sprintf(src, "v%d", i), graph_add_vertex(graph, src);
+	for (i = 0; graph && i < 300; i++)
+	{
+		sprintf(src, "v%d", rand() % 60), sprintf(dest, "v%d", rand() % 60);
+		graph_add_edge_weighted(graph, src, dest, rand() % 50,
+								i % 2 ? BIDIRECTIONAL : UNIDIRECTIONAL);
+	}
+	for (i = 0; graph && i < 60; i += 7)
+		sprintf(src, "v%d", i), graph_remove_vertex(graph, src);
+	fails += !graph || !graph_save(graph, IMG_PATH);
+	first = graph_mmap_open(IMG_PATH), second = graph_mmap_open(IMG_PATH);
+	fails += !same_graph(graph, first) + !same_graph(graph, second);
+	file = fopen(IMG_PATH, "rb");
+	if (file && fseek(file, 0, SEEK_END) == 0 && (len = ftell(file)) > 0)
+		buf = malloc(len);
+	if (file && buf && (fseek(file, 0, SEEK_SET) || !fread(buf, len, 1, file)))
+		free(buf), buf = NULL;
+	if (file)
+		fclose(file);
+	/* Forged images are relocated while first holds their base, then not */
+	fails += buf ? check_forgeries(buf, len) : 1;
+	graph_delete(first), graph_delete(second);
+	fails += buf ? check_forgeries(buf, len) : 1;
+	free(buf);
+	remove(IMG_PATH), remove(BAD_PATH);
+	graph_delete(graph);
+	printf("graph images: %d failure(s)\n", fails);
+	return (fails ? EXIT_FAILURE : EXIT_SUCCESS);
+}
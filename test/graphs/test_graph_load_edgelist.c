@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graphs.h"
+
+/*
+ * Checks that graph_load_edgelist builds the graph a text or binary edge
+ * list describes, and that it refuses truncated and malformed files.
+ * Build it with the sources of graphs, -Igraphs and -lpthread, and run it
+ * from a writable directory.
+ */
+
+#define LIST_PATH "test_graph_load_edgelist.txt"
+
+/* A binary edge list of 5 ids (4 is isolated) and 4 edges, one a loop */
+static const unsigned char binary[] = {
+	'G', 'E', 'L', '1', 5, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 1, 0, 0, 0,
+	1, 0, 0, 0, 2, 0, 0, 0,
+	3, 0, 0, 0, 3, 0, 0, 0,
+	2, 0, 0, 0, 0, 0, 0, 0
+};
+
+/**
+ * load - Writes a buffer to a file, then loads it as an edge list.
+ * @buf: The bytes of the file.
+ * @len: Number of bytes.
+ * @type: The type of the edges.
+ *
+ * Return: A pointer to the loaded graph, or NULL on failure.
+ */
+static graph_t *load(const void *buf, size_t len, edge_type_t type)
+{
+	FILE *file = fopen(LIST_PATH, "wb");
+	int ok;
+
+	if (!file)
+		return (NULL);
+	ok = fwrite(buf, 1, len, file) == len;
+	if (fclose(file) != 0 || !ok)
+		return (NULL);
+	return (graph_load_edgelist(LIST_PATH, type));
+}
+
+/**
+ * has_edge - Checks whether a graph holds an edge.
+ * @graph: Pointer to the graph.
+ * @src: Name of the source vertex.
+ * @dest: Name of the destination vertex.
+ *
+ * Return: 1 if the edge exists, 0 otherwise.
+ */
+static int has_edge(const graph_t *graph, const char *src, const char *dest)
+{
+	const vertex_t *v = graph_find_vertex(graph, src);
+	const edge_t *e;
+
+	for (e = v ? v->edges : NULL; e; e = e->next)
+		if (!strcmp(e->dest->content, dest))
+			return (1);
+	return (0);
+}
+
+/**
+ * rejects - Checks that graph_load_edgelist refuses a file.
+ * @buf: The bytes of the file.
+ * @len: Number of bytes.
+ *
+ * Return: 1 if the file is refused, 0 otherwise.
+ */
+static int rejects(const void *buf, size_t len)
+{
+	graph_t *graph = load(buf, len, UNIDIRECTIONAL);
+
+	graph_delete(graph);
+	return (graph == NULL);
+}
+
+/**
+ * check_binary - Loads the binary edge list whole, truncated and forged.
+ *
+ * Return: Number of failed checks.
+ */
+static int check_binary(void)
+{
+	unsigned char copy[sizeof(binary)];
+	graph_t *graph = load(binary, sizeof(binary), UNIDIRECTIONAL);
+	size_t cut;
+	int fails = 0;
+
+	fails += !graph || graph->nb_vertices != 5 ||
+		!has_edge(graph, "0", "1") || !has_edge(graph, "1", "2") ||
+		!has_edge(graph, "2", "0") || has_edge(graph, "3", "3") ||
+		!graph_find_vertex(graph, "4") || has_edge(graph, "1", "0");
+	graph_delete(graph);
+	for (cut = 4; cut < sizeof(binary); cut++)
+		fails += !rejects(binary, cut);
+	memcpy(copy, binary, sizeof(copy));
+	copy[8] = 5; /* One edge more than the file holds */
+	fails += !rejects(copy, sizeof(copy));
+	copy[8] = 4, copy[13] = 1; /* 2^40 edges */
+	fails += !rejects(copy, sizeof(copy));
+	copy[13] = 0, copy[sizeof(copy) - 4] = 5; /* Id past nb_v */
+	fails += !rejects(copy, sizeof(copy));
+	copy[sizeof(copy) - 4] = 0, copy[sizeof(copy) - 1] = 0x80;
+	fails += !rejects(copy, sizeof(copy));
+	copy[sizeof(copy) - 1] = 0;
+	memset(copy + 4, 0xff, 4); /* 2^32 - 1 ids for 4 edges */
+	fails += !rejects(copy, sizeof(copy));
+	return (fails);
+}
+
+/**
+ * main - Loads text edge lists (with comments, blank lines, a self-loop,
+ * extra fields, a repeated edge and no final newline) and binary ones.
+ *
+ * Return: EXIT_SUCCESS if every check passes, EXIT_FAILURE otherwise.
+ */
+int main(void)
+{
+	const char *text = "# comment\n\n% comment\n  a\tb weight\r\n"
+		"b c\nc c\na b\n\t\nc a";
+	graph_t *graph;
+	int fails = 0;
+
+	graph = load(text, strlen(text), UNIDIRECTIONAL);
+	fails += !graph || graph->nb_vertices != 3 ||
+		!has_edge(graph, "a", "b") || !has_edge(graph, "b", "c") ||
+		graph_find_vertex(graph, "a")->nb_edges != 1 ||
+		!has_edge(graph, "c", "a") || has_edge(graph, "b", "a") ||
+		has_edge(graph, "c", "c");
+	graph_delete(graph);
+	graph = load(text, strlen(text), BIDIRECTIONAL);
+	fails += !graph || graph->nb_vertices != 3 ||
+		!has_edge(graph, "b", "a") || !has_edge(graph, "a", "c");
+	graph_delete(graph);
+	fails += !rejects("a b\nc\nd e\n", 10) + !rejects("a b\n   c \n", 10);
+	fails += check_binary();
+	remove(LIST_PATH);
+	printf("edge lists: %d failure(s)\n", fails);
+	return (fails ? EXIT_FAILURE : EXIT_SUCCESS);
+}
@@ -0,0 +1,166 @@
+#include <string.h>
+#include "pathfinding.h"
+
+/*
+ * Checks that ch_load rejects truncated and forged contraction hierarchy
+ * files instead of trusting them. Build it with the sources of graphs and
+ * pathfinding and the queues module, -Igraphs -Ipathfinding and
+ * -lpthread, and run it from a writable directory.
+ */
+
+#define CH_PATH "test_ch_file.ch"
+#define BAD_PATH "test_ch_file_bad.ch"
+#define MAX_FILE 4096
+
+/**
+ * write_file - Writes a buffer to a file.
+ * @path: Path of the file.
+ * @buf: The bytes to write.
+ * @len: Number of bytes.
+ *
+ * Return: 1 on success, 0 on failure.
+ */
+static int write_file(const char *path, const void *buf, size_t len)
+{
+	FILE *file = fopen(path, "wb");
+	int ok;
+
+	if (!file)
+		return (0);
+	ok = fwrite(buf, 1, len, file) == len;
+	return (fclose(file) == 0 && ok);
+}
+
+/**
+ * rejects - Checks that ch_load refuses a file.
+ * @buf: The bytes of the file.
+ * @len: Number of bytes.
+ * @graph: Pointer to the graph to load it for.
+ *
+ * Return: 1 if the file is refused, 0 otherwise.
+ */
+static int rejects(const void *buf, size_t len, const graph_t *graph)
+{
+	ch_t *ch;
+
+	if (!write_file(BAD_PATH, buf, len))
+		return (0);
+	ch = ch_load(BAD_PATH, graph);
+	ch_delete(ch);
+	return (ch == NULL);
+}
+
+/**
+ * save_looping - Saves a hierarchy whose first node has an arc to itself
+ * in each direction, both shortcuts through itself: unpacking them would
+ * never end.
+ * @graph: Pointer to a graph of two vertices.
+ *
+ * Return: 1 on success, 0 on failure.
+ */
+static int save_looping(const graph_t *graph)
+{
+	ch_t *ch = ch_alloc(2, 1, 1, graph->nb_slots);
+	int ok;
+
+	if (!ch)
+		return (0);
+	ch->verts[0] = graph->vertices, ch->verts[1] = graph->vertices->next;
+	ch->rank[0] = 0, ch->rank[1] = 1;
+	ch->up_first[0] = ch->down_first[0] = 0;
+	ch->up_first[1] = ch->up_first[2] = 1;
+	ch->down_first[1] = ch->down_first[2] = 1;
+	ch->up[0].node = ch->down[0].node = 0;
+	ch->up[0].middle = ch->down[0].middle = 0;
+	ch->up[0].weight = ch->down[0].weight = 1;
+	ok = ch_save(ch, BAD_PATH);
+	ch_delete(ch);
+	return (ok);
+}
+
+/**
+ * check_forgeries - Loads altered copies of a valid hierarchy file.
+ * @buf: The bytes of the valid file.
+ * @len: Number of bytes.
+ * @graph: Pointer to the graph it was built from.
+ *
+ * Return: Number of altered files that were not refused.
+ */
+static int check_forgeries(const unsigned char *buf, size_t len,
+						   const graph_t *graph)
+{
+	unsigned char copy[MAX_FILE];
+	ch_file_t hdr;
+	int fails = 0, i;
+	size_t cut;
+
+	for (cut = 0; cut < len; cut += 1 + len / 64)
+		fails += !rejects(buf, cut, graph);
+	for (i = 0; i < 5; i++)
+	{
+		memcpy(copy, buf, len);
+		memcpy(&hdr, copy, sizeof(hdr));
+		if (i == 0)
+			hdr.nb_nodes = ((uint64_t)1 << 62) + 1;
+		else if (i == 1)
+			hdr.nb_up = (uint64_t)1 << 61;
+		else if (i == 2)
+			hdr.strings_size += 8;
+		else if (i == 3)
+			hdr.nb_nodes = graph->nb_vertices + 1;
+		else
+			hdr.version++;
+		memcpy(copy, &hdr, sizeof(hdr));
+		fails += !rejects(copy, len, graph);
+	}
+	memcpy(copy, buf, len);
+	copy[len] = 0;
+	fails += !rejects(copy, len + 1, graph); /* Trailing byte */
+	return (fails);
+}
+
+/**
+ * main - Saves the hierarchy of a small graph, then loads it back whole,
+ * truncated, forged and looping.
+ *
+ * Return: EXIT_SUCCESS if only the valid file loads, EXIT_FAILURE
+ * otherwise.
+ */
+int main(void)
+{
+	graph_t *graph = graph_create();
+	unsigned char buf[MAX_FILE + 1];
+	ch_t *ch;
+	FILE *file;
+	size_t len = 0;
+	int fails = 0;
+
+	graph_add_vertex(graph, "a"), graph_add_vertex(graph, "b");
+	graph_add_vertex(graph, "c");
+	graph_add_edge_weighted(graph, "a", "b", 2, BIDIRECTIONAL);
+	graph_add_edge_weighted(graph, "b", "c", 3, UNIDIRECTIONAL);
+	ch = ch_build(graph);
+	if (!ch || !ch_save(ch, CH_PATH))
+		fails++;
+	ch_delete(ch);
+	file = fopen(CH_PATH, "rb");
+	if (file)
+		len = fread(buf, 1, MAX_FILE, file), fclose(file);
+	ch = ch_load(CH_PATH, graph);
+	fails += !ch || len == 0 || len == MAX_FILE;
+	ch_delete(ch);
+	if (len > 0 && len < MAX_FILE)
+		fails += check_forgeries(buf, len, graph);
+	if (save_looping(graph))
+	{
+		ch = ch_load(BAD_PATH, graph);
+		fails += ch != NULL;
+		ch_delete(ch);
+	}
+	else
+		fails++;
+	remove(CH_PATH), remove(BAD_PATH);
+	graph_delete(graph);
+	printf("ch files: %d failure(s)\n", fails);
+	return (fails ? EXIT_FAILURE : EXIT_SUCCESS);
+}
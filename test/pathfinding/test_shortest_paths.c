@@ -0,0 +1,189 @@
+#include <limits.h>
+#include <string.h>
+#include "pathfinding.h"
+
+/*
+ * Checks dijkstra_graph, astar_graph, bidirectional_dijkstra_graph (with
+ * and without tracked incoming edges) and ch_query, before and after
+ * ch_save / ch_load, against Bellman-Ford on random weighted graphs with
+ * removed vertices. Build it with the sources of graphs and pathfinding
+ * and the queues module, -Igraphs -Ipathfinding and -lpthread, and run it
+ * from a writable directory.
+ */
+
+#define NB_GRAPHS 120
+#define MAX_VERTICES 40
+#define CH_PATH "test_shortest_paths.ch"
+
+/**
+ * zero_heuristic - Heuristic of astar_graph that never overestimates.
+ * @v: Unused.
+ * @target: Unused.
+ * @arg: Unused.
+ *
+ * Return: Always 0.
+ */
+static int zero_heuristic(vertex_t const *v, vertex_t const *target,
+						  void *arg)
+{
+	(void)v, (void)target, (void)arg;
+	return (0);
+}
+
+/**
+ * random_graph - Builds a random graph with weighted edges (some of
+ * weight 0), some vertices removed before and after the edges are added.
+ * @seed: Seed of the graph.
+ *
+ * Return: A pointer to the graph, or NULL on failure.
+ */
+static graph_t *random_graph(unsigned int seed)
+{
+	graph_t *graph = graph_create();
+	char src[16], dest[16];
+	int i, n = 2 + seed % (MAX_VERTICES - 1), m = n * (1 + seed % 4);
+
+	srand(seed);
+	for (i = 0; graph && i < n; i++)
+	{
+		sprintf(src, "v%d", i);
+		graph_add_vertex(graph, src);
+	}
+	for (i = 0; graph && seed % 3 == 0 && i < n; i += 5)
+	{
+		sprintf(src, "v%d", i);
+		graph_remove_vertex(graph, src);
+	}
+	for (i = 0; graph && i < m; i++)
+	{
+		sprintf(src, "v%d", rand() % n);
+		sprintf(dest, "v%d", rand() % n);
+		graph_add_edge_weighted(graph, src, dest, rand() % 20,
+								rand() % 2 ? BIDIRECTIONAL : UNIDIRECTIONAL);
+	}
+	for (i = 1; graph && seed % 4 == 0 && i < n; i += 7)
+	{
+		sprintf(src, "v%d", i);
+		graph_remove_vertex(graph, src);
+	}
+	return (graph);
+}
+
+/**
+ * bellman_ford - Computes the distances from a vertex to every vertex.
+ * @graph: Pointer to the graph.
+ * @start: The starting vertex.
+ * @dist: Receives the distance of each vertex index, INT_MAX if
+ * unreachable (nb_slots entries).
+ */
+static void bellman_ford(const graph_t *graph, const vertex_t *start,
+						 int *dist)
+{
+	const vertex_t *v;
+	const edge_t *e;
+	size_t i;
+	int changed = 1;
+
+	for (i = 0; i < graph->nb_slots; i++)
+		dist[i] = INT_MAX;
+	dist[start->index] = 0;
+	while (changed)
+	{
+		changed = 0;
+		for (v = graph->vertices; v; v = v->next)
+			for (e = v->edges; dist[v->index] != INT_MAX && e; e = e->next)
+				if (dist[v->index] + e->weight < dist[e->dest->index])
+				{
+					dist[e->dest->index] = dist[v->index] + e->weight;
+					changed = 1;
+				}
+	}
+}
+
+/**
+ * check_path - Checks a path returned by a search, and frees it.
+ * @graph: Pointer to the graph searched.
+ * @path: The path, or NULL.
+ * @start: The starting vertex.
+ * @target: The target vertex.
+ * @dist: Length of the shortest path, INT_MAX if there is none.
+ *
+ * Return: 1 if the path is a shortest path from @start to @target (or
+ * NULL when there is none), 0 otherwise.
+ */
+static int check_path(const graph_t *graph, queue_t *path,
+					  const vertex_t *start, const vertex_t *target, int dist)
+{
+	const vertex_t *prev = NULL, *v;
+	const edge_t *e;
+	char *name;
+	long cost = 0;
+	int ok = 1;
+
+	if (!path)
+		return (dist == INT_MAX);
+	while ((name = dequeue(path)) != NULL)
+	{
+		v = graph_find_vertex(graph, name);
+		if (!prev)
+			ok = ok && v == start;
+		for (e = prev ? prev->edges : NULL; e && e->dest != v; e = e->next)
+			;
+		if (prev && e)
+			cost += e->weight;
+		ok = ok && v && (!prev || e);
+		prev = v;
+		free(name);
+	}
+	queue_delete(path);
+	return (ok && prev == target && cost == dist);
+}
+
+/**
+ * main - Runs every search between every pair of vertices of random
+ * graphs, and compares them with Bellman-Ford.
+ *
+ * Return: EXIT_SUCCESS if every search agrees, EXIT_FAILURE otherwise.
+ */
+int main(void)
+{
+	graph_t *graph;
+	ch_t *ch, *loaded;
+	ch_query_ctx_t *ctx;
+	const vertex_t *s, *t;
+	int dist[MAX_VERTICES + 1], fails = 0;
+	unsigned int seed;
+
+	for (seed = 1; seed <= NB_GRAPHS; seed++)
+	{
+		graph = random_graph(seed);
+		ch = graph ? ch_build(graph) : NULL;
+		loaded = ch && ch_save(ch, CH_PATH) ? ch_load(CH_PATH, graph) : NULL;
+		ctx = ch ? ch_query_ctx_create(ch) : NULL;
+		if (!loaded || !ctx)
+			fails++;
+		else if (seed % 2)
+			graph_track_in_edges(graph);
+		for (s = loaded && ctx ? graph->vertices : NULL; s; s = s->next)
+		{
+			bellman_ford(graph, s, dist);
+			for (t = graph->vertices; t; t = t->next)
+				fails += !check_path(graph, dijkstra_graph(graph, s, t), s, t,
+									 dist[t->index]) +
+					!check_path(graph, astar_graph(graph, s, t, zero_heuristic,
+												   NULL), s, t, dist[t->index]) +
+					!check_path(graph, bidirectional_dijkstra_graph(graph, s, t),
+								s, t, dist[t->index]) +
+					!check_path(graph, ch_query(ch, ctx, s, t), s, t,
+								dist[t->index]) +
+					!check_path(graph, ch_query(loaded, NULL, s, t), s, t,
+								dist[t->index]);
+		}
+		ch_query_ctx_delete(ctx);
+		ch_delete(ch), ch_delete(loaded);
+		graph_delete(graph);
+	}
+	remove(CH_PATH);
+	printf("shortest paths: %d failure(s)\n", fails);
+	return (fails ? EXIT_FAILURE : EXIT_SUCCESS);
+}